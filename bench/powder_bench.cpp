@@ -0,0 +1,348 @@
+// ============================================================================
+// Wasm Powder Toy - 헤드리스 벤치마크
+// ----------------------------------------------------------------------------
+// 정해진 장면을 여러 월드 크기에서 실행하고 프레임당 시간과 패스별 시간을
+// 출력합니다. --json / --csv 출력은 릴리스 간 회귀 추적용입니다.
+//
+//   powder_bench [--frames N] [--sizes 200x150,400x300] [--scene 이름]
+//                [--seed N] [--threads N] [--async-heat]
+//                [--heat-solver explicit|adi|multires] [--heat-interval K] [--json | --csv]
+//
+// --async-heat 이면 열 전도를 작업 스레드에서 한 프레임 늦게 실행하며,
+// heat 열은 메인 스레드가 쓴 시간(복사 + 결과 대기 + 합치기)만 나타냄
+//
+// adi는 풀이 1회가 explicit보다 비싸므로 (800x600 Release: adi 약 3.3 ms, explicit 약 0.9 ms)
+// --heat-interval 4 이상으로 풀이 횟수를 줄일 때만 이득
+// ============================================================================
+#include "world_step.h"
+#include "core/grid.h"
+#include "chemistry/reaction_registry.h"
+#include "core/thread_pool.h"
+#include "core/background_worker.h"
+#include "physics/heat_conduction.h"
+#include "particle.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// 장면 (월드 크기에 비례하여 배치)
+// ============================================================================
+
+// 사각형 영역 [x0, x1) x [y0, y1) 을 채움
+static void fillRect(World& world, int x0, int y0, int x1, int y1, int type) {
+  for (int y = y0; y < y1; y++) {
+    for (int x = x0; x < x1; x++) {
+      addParticle(world, x, y, type);
+    }
+  }
+}
+
+// 아무것도 없는 월드 (스케줄러 오버헤드 측정)
+static void sceneEmpty(World&) {}
+
+// 가운데 모래 기둥이 무너져 쌓임
+static void sceneSandColumn(World& world) {
+  int w = world.width, h = world.height;
+  fillRect(world, w * 3 / 8, 0, w * 5 / 8, h * 3 / 4, SAND);
+}
+
+// 왼쪽 위의 물 덩어리가 월드 전체로 퍼짐
+static void sceneWaterFlood(World& world) {
+  int w = world.width, h = world.height;
+  fillRect(world, 0, 0, w / 2, h / 2, WATER);
+}
+
+// 나무 바닥 위 기름 웅덩이에 불을 붙임
+static void sceneWoodOilFire(World& world) {
+  int w = world.width, h = world.height;
+  fillRect(world, 0, h * 3 / 4, w, h, WOOD);
+  fillRect(world, w / 8, h * 5 / 8, w * 7 / 8, h * 3 / 4, OIL);
+  for (int x = w / 8; x < w * 7 / 8; x += 8) {
+    addParticle(world, x, h * 5 / 8 - 1, FIRE);
+  }
+}
+
+// 물 위에 리튬/나트륨 덩어리를 떨어뜨림 (수소 발생 → 폭발 연쇄)
+static void sceneMetalWater(World& world) {
+  int w = world.width, h = world.height;
+  fillRect(world, 0, h / 2, w, h, WATER);
+  fillRect(world, w / 4 - 8, h / 4, w / 4 + 8, h / 4 + 8, LITHIUM);
+  fillRect(world, w * 3 / 4 - 8, h / 4, w * 3 / 4 + 8, h / 4 + 8, SODIUM);
+}
+
+// 수소 구름 가운데에 불꽃 1개
+static void sceneHydrogenDetonation(World& world) {
+  int w = world.width, h = world.height;
+  // addParticle은 빈 칸에만 놓으므로 불꽃을 먼저 배치
+  fillRect(world, w / 2 - 1, h / 2 - 1, w / 2 + 1, h / 2 + 1, FIRE);
+  fillRect(world, w / 4, h / 4, w * 3 / 4, h * 3 / 4, HYDROGEN);
+}
+
+// 빈 월드에 달군 철 덩어리 4개 (대부분 공기인 월드의 열 전도 측정)
+static void sceneHotMetal(World& world) {
+  int w = world.width, h = world.height;
+  int bw = w / 16 > 1 ? w / 16 : 1;
+  int bh = h / 16 > 1 ? h / 16 : 1;
+  for (int i = 0; i < 4; i++) {
+    int x0 = w * (2 * i + 1) / 8 - bw / 2;
+    int y0 = h * ((i & 1) ? 5 : 3) / 8 - bh / 2;
+    fillRect(world, x0, y0, x0 + bw, y0 + bh, IRON);
+    for (int y = y0; y < y0 + bh; y++) {
+      for (int x = x0; x < x0 + bw; x++) {
+        setTemperature(world.grid, getIndex(world, x, y), 800.0f);
+      }
+    }
+  }
+}
+
+struct Scene {
+  const char* name;
+  void (*setup)(World& world);
+};
+
+static const Scene SCENES[] = {
+  {"empty", sceneEmpty},
+  {"sand_column", sceneSandColumn},
+  {"water_flood", sceneWaterFlood},
+  {"wood_oil_fire", sceneWoodOilFire},
+  {"metal_water", sceneMetalWater},
+  {"hydrogen_detonation", sceneHydrogenDetonation},
+  {"hot_metal", sceneHotMetal},
+};
+static const int SCENE_COUNT = sizeof(SCENES) / sizeof(SCENES[0]);
+
+// ============================================================================
+// 실행 및 출력
+// ============================================================================
+
+enum OutputFormat { OUTPUT_TEXT, OUTPUT_JSON, OUTPUT_CSV };
+
+struct BenchResult {
+  const char* scene;
+  int width;
+  int height;
+  PassTimings timings;
+  uint64_t total_ns;
+  int particles;               // 마지막 프레임의 입자 수
+  int threads;
+};
+
+static BenchResult runScene(const Scene& scene, int width, int height, int frames,
+                            unsigned seed, ReactionRegistry& registry, ThreadPool* pool,
+                            BackgroundWorker* thermalWorker, HeatSolver heatSolver,
+                            int heatInterval) {
+  World world;
+  initWorld(world, width, height);
+  world.reactions = &registry;
+  world.threadPool = pool;
+  world.thermalWorker = thermalWorker;
+  world.thermalSolver = heatSolver;
+  world.thermalInterval = heatInterval;
+
+  setWorldSeed(world, seed);
+  scene.setup(world);
+
+  BenchResult result;
+  result.scene = scene.name;
+  result.width = world.width;
+  result.height = world.height;
+  result.threads = pool ? pool->getThreadCount() : 1;
+  for (int f = 0; f < frames; f++) {
+    stepWorld(world, &result.timings);
+  }
+  finishHeatConductionAsync(world);
+
+  const PassTimings& t = result.timings;
+  result.total_ns = t.prepare_ns + t.chemistry_ns + t.heat_ns + t.forces_ns +
+                    t.life_ns + t.movement_ns + t.render_ns;
+
+  result.particles = 0;
+  for (int i = 0; i < world.size; i++) {
+    if (world.renderBuffer[i] != EMPTY) result.particles++;
+  }
+  return result;
+}
+
+// 프레임당 평균 (나노초)
+static double perFrame(uint64_t ns, int frames) {
+  return frames > 0 ? static_cast<double>(ns) / frames : 0.0;
+}
+
+static double framesPerSecond(const BenchResult& r) {
+  return r.total_ns > 0 ? r.timings.frames * 1e9 / r.total_ns : 0.0;
+}
+
+static void printText(const std::vector<BenchResult>& results) {
+  printf("%-20s %9s %7s %9s %10s %10s %10s %10s %10s %10s %10s %10s\n",
+         "scene", "size", "threads", "fps", "ns/frame", "prepare", "chemistry",
+         "heat", "forces", "life", "movement", "render");
+  for (const BenchResult& r : results) {
+    const PassTimings& t = r.timings;
+    char size[32];
+    snprintf(size, sizeof(size), "%dx%d", r.width, r.height);
+    printf("%-20s %9s %7d %9.1f %10.0f %10.0f %10.0f %10.0f %10.0f %10.0f %10.0f %10.0f\n",
+           r.scene, size, r.threads, framesPerSecond(r), perFrame(r.total_ns, t.frames),
+           perFrame(t.prepare_ns, t.frames), perFrame(t.chemistry_ns, t.frames),
+           perFrame(t.heat_ns, t.frames), perFrame(t.forces_ns, t.frames), perFrame(t.life_ns, t.frames),
+           perFrame(t.movement_ns, t.frames), perFrame(t.render_ns, t.frames));
+  }
+}
+
+static void printCsv(const std::vector<BenchResult>& results) {
+  printf("scene,width,height,threads,frames,particles,fps,ns_per_frame,"
+         "prepare_ns,chemistry_ns,heat_ns,forces_ns,life_ns,movement_ns,render_ns\n");
+  for (const BenchResult& r : results) {
+    const PassTimings& t = r.timings;
+    printf("%s,%d,%d,%d,%d,%d,%.2f,%.0f,%.0f,%.0f,%.0f,%.0f,%.0f,%.0f,%.0f\n",
+           r.scene, r.width, r.height, r.threads, t.frames, r.particles, framesPerSecond(r),
+           perFrame(r.total_ns, t.frames),
+           perFrame(t.prepare_ns, t.frames), perFrame(t.chemistry_ns, t.frames),
+           perFrame(t.heat_ns, t.frames), perFrame(t.forces_ns, t.frames), perFrame(t.life_ns, t.frames),
+           perFrame(t.movement_ns, t.frames), perFrame(t.render_ns, t.frames));
+  }
+}
+
+static void printJson(const std::vector<BenchResult>& results, unsigned seed) {
+  printf("{\n  \"seed\": %u,\n  \"results\": [\n", seed);
+  for (size_t i = 0; i < results.size(); i++) {
+    const BenchResult& r = results[i];
+    const PassTimings& t = r.timings;
+    printf("    {\"scene\": \"%s\", \"width\": %d, \"height\": %d, \"threads\": %d, "
+           "\"frames\": %d, \"particles\": %d, \"fps\": %.2f, \"ns_per_frame\": %.0f, "
+           "\"passes_ns\": {\"prepare\": %.0f, \"chemistry\": %.0f, \"heat\": %.0f, \"forces\": %.0f, "
+           "\"life\": %.0f, \"movement\": %.0f, \"render\": %.0f}}%s\n",
+           r.scene, r.width, r.height, r.threads, t.frames, r.particles, framesPerSecond(r),
+           perFrame(r.total_ns, t.frames),
+           perFrame(t.prepare_ns, t.frames), perFrame(t.chemistry_ns, t.frames),
+           perFrame(t.heat_ns, t.frames),
+           perFrame(t.forces_ns, t.frames), perFrame(t.life_ns, t.frames),
+           perFrame(t.movement_ns, t.frames), perFrame(t.render_ns, t.frames),
+           i + 1 < results.size() ? "," : "");
+  }
+  printf("  ]\n}\n");
+}
+
+// "200x150,400x300" → 크기 목록
+static bool parseSizes(const char* text, std::vector<int>& widths, std::vector<int>& heights) {
+  widths.clear();
+  heights.clear();
+  std::string list(text);
+  size_t start = 0;
+  while (start < list.size()) {
+    size_t end = list.find(',', start);
+    if (end == std::string::npos) end = list.size();
+    int w = 0, h = 0;
+    if (sscanf(list.substr(start, end - start).c_str(), "%dx%d", &w, &h) != 2 || w <= 0 || h <= 0)
+      return false;
+    widths.push_back(w);
+    heights.push_back(h);
+    start = end + 1;
+  }
+  return !widths.empty();
+}
+
+static void printUsage(const char* program) {
+  fprintf(stderr,
+          "usage: %s [--frames N] [--sizes WxH,...] [--scene NAME] [--seed N] [--threads N] [--async-heat]\n"
+          "          [--heat-solver explicit|adi|multires] [--heat-interval K] [--json | --csv]\n"
+          "  adi costs ~3.7x explicit per solve; it only pays off with --heat-interval >= 4\n"
+          "scenes:", program);
+  for (int i = 0; i < SCENE_COUNT; i++) fprintf(stderr, " %s", SCENES[i].name);
+  fprintf(stderr, "\n");
+}
+
+int main(int argc, char** argv) {
+  int frames = 300;
+  int threads = 1;
+  bool asyncHeat = false;
+  HeatSolver heatSolver = HEAT_SOLVER_EXPLICIT;
+  int heatInterval = 1;
+  unsigned seed = 12345;
+  const char* sceneFilter = nullptr;
+  OutputFormat format = OUTPUT_TEXT;
+  std::vector<int> widths = {200, 400, 800};
+  std::vector<int> heights = {150, 300, 600};
+
+  for (int i = 1; i < argc; i++) {
+    const char* arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (strcmp(arg, "--frames") == 0 && hasValue) {
+      frames = atoi(argv[++i]);
+    } else if (strcmp(arg, "--seed") == 0 && hasValue) {
+      seed = static_cast<unsigned>(strtoul(argv[++i], nullptr, 10));
+    } else if (strcmp(arg, "--threads") == 0 && hasValue) {
+      threads = atoi(argv[++i]);
+    } else if (strcmp(arg, "--scene") == 0 && hasValue) {
+      sceneFilter = argv[++i];
+    } else if (strcmp(arg, "--sizes") == 0 && hasValue) {
+      if (!parseSizes(argv[++i], widths, heights)) {
+        printUsage(argv[0]);
+        return 1;
+      }
+    } else if (strcmp(arg, "--heat-solver") == 0 && hasValue) {
+      const char* name = argv[++i];
+      if (strcmp(name, "adi") == 0) {
+        heatSolver = HEAT_SOLVER_ADI;
+      } else if (strcmp(name, "multires") == 0) {
+        heatSolver = HEAT_SOLVER_MULTIRES;
+      } else if (strcmp(name, "explicit") == 0) {
+        heatSolver = HEAT_SOLVER_EXPLICIT;
+      } else {
+        printUsage(argv[0]);
+        return 1;
+      }
+    } else if (strcmp(arg, "--heat-interval") == 0 && hasValue) {
+      heatInterval = atoi(argv[++i]);
+    } else if (strcmp(arg, "--async-heat") == 0) {
+      asyncHeat = true;
+    } else if (strcmp(arg, "--json") == 0) {
+      format = OUTPUT_JSON;
+    } else if (strcmp(arg, "--csv") == 0) {
+      format = OUTPUT_CSV;
+    } else {
+      printUsage(argv[0]);
+      return 1;
+    }
+  }
+
+  if (frames <= 0 || heatInterval <= 0) {
+    printUsage(argv[0]);
+    return 1;
+  }
+
+  // 모든 장면이 같은 반응 규칙을 사용
+  ReactionRegistry registry;
+  registry.initializeAllReactions();
+
+  // 2 이상이면 이동 패스를 병렬 실행
+  ThreadPool pool(threads);
+  ThreadPool* poolPtr = threads > 1 ? &pool : nullptr;
+
+  BackgroundWorker thermalWorker;
+  BackgroundWorker* thermalPtr = asyncHeat ? &thermalWorker : nullptr;
+
+  std::vector<BenchResult> results;
+  for (int s = 0; s < SCENE_COUNT; s++) {
+    if (sceneFilter && strcmp(sceneFilter, SCENES[s].name) != 0) continue;
+    for (size_t i = 0; i < widths.size(); i++) {
+      results.push_back(runScene(SCENES[s], widths[i], heights[i], frames, seed, registry, poolPtr, thermalPtr,
+                                  heatSolver, heatInterval));
+    }
+  }
+
+  if (results.empty()) {
+    fprintf(stderr, "unknown scene: %s\n", sceneFilter);
+    printUsage(argv[0]);
+    return 1;
+  }
+
+  switch (format) {
+  case OUTPUT_JSON: printJson(results, seed); break;
+  case OUTPUT_CSV: printCsv(results); break;
+  default: printText(results); break;
+  }
+  return 0;
+}
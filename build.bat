@@ -1,4 +1,5 @@
 @echo off
+setlocal
 REM Wasm Powder Toy Build Script (Windows - Modular)
 chcp 65001 >nul
 
@@ -17,22 +18,57 @@ if %ERRORLEVEL% NEQ 0 (
 REM 출력 디렉토리 생성
 if not exist web mkdir web
 
+REM 기본 월드 크기 (환경 변수로 변경 가능: set WORLD_WIDTH=800 ^& set WORLD_HEIGHT=600 ^& build.bat)
+if "%WORLD_WIDTH%"=="" set WORLD_WIDTH=400
+if "%WORLD_HEIGHT%"=="" set WORLD_HEIGHT=300
+
+REM 온도 평면을 float로 저장하려면 set TEMPERATURE_FP32=1 후 빌드 (기본은 int16 고정소수점)
+set TEMPERATURE_FLAGS=
+if "%TEMPERATURE_FP32%"=="1" set TEMPERATURE_FLAGS=-DPOWDER_TEMPERATURE_FP32
+
+REM 셀 평면을 청크(16x16) 타일 단위로 배치하려면 set TILED_LAYOUT=1 후 빌드 (기본은 행 우선)
+set LAYOUT_FLAGS=
+if "%TILED_LAYOUT%"=="1" set LAYOUT_FLAGS=-DPOWDER_TILED_LAYOUT
+
+REM 초기 메모리: 셀당 약 30바이트 (평면 9바이트 x 2 버퍼 + 온도 2~4바이트 + 렌더 버퍼 4바이트 + 여유)
+REM + 16MB 여유, 64KB 페이지 단위로 올림
+set /a CELLS=WORLD_WIDTH * WORLD_HEIGHT
+set /a INITIAL_MEMORY=(CELLS * 30 + 16777216 + 65535) / 65536 * 65536
+echo Default world: %WORLD_WIDTH%x%WORLD_HEIGHT% (INITIAL_MEMORY=%INITIAL_MEMORY%)
+
 REM C++를 WebAssembly로 컴파일 (모든 모듈 포함)
 emcc src\simulation.cpp ^
+    src\world_step.cpp ^
+    src\core\world.cpp ^
     src\core\grid.cpp ^
+    src\core\chunk_manager.cpp ^
+    src\core\occupancy.cpp ^
+    src\core\thread_pool.cpp ^
+    src\core\background_worker.cpp ^
     src\physics\heat_conduction.cpp ^
     src\physics\state_change.cpp ^
     src\physics\forces.cpp ^
     src\physics\movement.cpp ^
     src\materials\special_materials.cpp ^
+    src\materials\material_table.cpp ^
+    src\chemistry\reaction_system.cpp ^
+    src\chemistry\reaction_registry.cpp ^
+    src\chemistry\reactions\combustion.cpp ^
+    src\chemistry\reactions\water_metal.cpp ^
+    src\chemistry\reactions\evaporation.cpp ^
     -o web\simulation.js ^
     -s WASM=1 ^
-    -s EXPORTED_FUNCTIONS="[\"_init\",\"_update\",\"_getRenderBufferPtr\",\"_getParticleArrayPtr\",\"_getParticleSize\",\"_addParticleWrapper\",\"_getWidth\",\"_getHeight\",\"_malloc\",\"_free\"]" ^
-    -s EXPORTED_RUNTIME_METHODS="[\"ccall\",\"cwrap\",\"HEAP8\",\"HEAP32\",\"HEAPF32\",\"getValue\",\"setValue\"]" ^
+    -s EXPORTED_FUNCTIONS="[\"_init\",\"_initWithSize\",\"_setSeed\",\"_setThreadCount\",\"_setAsyncHeat\",\"_setHeatSolver\",\"_update\",\"_getRenderBufferPtr\",\"_getTemperaturePtr\",\"_getTemperatureBytes\",\"_getTemperatureScale\",\"_getTemperatureStride\",\"_addParticleWrapper\",\"_setTemperatureWrapper\",\"_getWidth\",\"_getHeight\",\"_malloc\",\"_free\"]" ^
+    -s EXPORTED_RUNTIME_METHODS="[\"ccall\",\"cwrap\",\"HEAP8\",\"HEAP16\",\"HEAP32\",\"HEAPF32\",\"getValue\",\"setValue\"]" ^
     -s ALLOW_MEMORY_GROWTH=1 ^
-    -s INITIAL_MEMORY=33554432 ^
+    -s INITIAL_MEMORY=%INITIAL_MEMORY% ^
+    -DDEFAULT_WORLD_WIDTH=%WORLD_WIDTH% ^
+    -DDEFAULT_WORLD_HEIGHT=%WORLD_HEIGHT% ^
+    %TEMPERATURE_FLAGS% ^
+    %LAYOUT_FLAGS% ^
     -O3 ^
-    -std=c++11 ^
+    -msimd128 ^
+    -std=c++17 ^
     -I src
 
 if %ERRORLEVEL% EQU 0 (
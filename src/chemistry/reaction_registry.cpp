@@ -2,9 +2,9 @@
 #include "reactions/combustion.h"
 #include "reactions/water_metal.h"
 #include "reactions/evaporation.h"
-#include <cstdlib>
+#include <cstring>
 
-// 싱글톤 인스턴스
+// 공유 인스턴스
 ReactionRegistry& ReactionRegistry::getInstance() {
     static ReactionRegistry instance;
     return instance;
@@ -12,53 +12,193 @@ ReactionRegistry& ReactionRegistry::getInstance() {
 
 // 반응 등록
 void ReactionRegistry::registerReaction(const ReactionRule& rule) {
+    // 범위를 벗어난 타입은 디스패치 테이블에 넣을 수 없음
+    if (rule.reactant_a < 0 || rule.reactant_a >= MATERIAL_COUNT ||
+        rule.reactant_b < 0 || rule.reactant_b >= MATERIAL_COUNT) {
+        return;
+    }
+    
     reactions.push_back(rule);
+    compileRules();
+}
+
+// 핸들러 결과의 중심/이웃 역할을 맞바꿈
+static void swapRoles(ReactionResult& result) {
+    int type = result.new_type_center;
+    result.new_type_center = result.new_type_neighbor;
+    result.new_type_neighbor = type;
+    
+    int life = result.life_center;
+    result.life_center = result.life_neighbor;
+    result.life_neighbor = life;
+}
+
+// 규칙을 (작은 타입, 큰 타입) 방향의 평면 행으로 변환
+static CompiledReaction compileRule(const ReactionRule& rule) {
+    // A가 작은 타입이면 A 쪽 결과가 [0]
+    int a = rule.reactant_a <= rule.reactant_b ? 0 : 1;
+    int b = a ^ 1;
+    
+    CompiledReaction row;
+    row.probability = rule.probability;
+    row.min_temperature = rule.min_temperature;
+    row.heat_released = rule.heat_released;
+    row.explosion_force = rule.explosion_force;
+    row.product[a] = static_cast<int16_t>(rule.product_a);
+    row.product[b] = static_cast<int16_t>(rule.product_b);
+    row.life_min[a] = static_cast<int16_t>(rule.life_a_min);
+    row.life_min[b] = static_cast<int16_t>(rule.life_b_min);
+    row.life_range[a] = static_cast<int16_t>(rule.life_a_range);
+    row.life_range[b] = static_cast<int16_t>(rule.life_b_range);
+    row.type_lo = static_cast<uint8_t>(a == 0 ? rule.reactant_a : rule.reactant_b);
+    row.explosion_radius = static_cast<uint8_t>(rule.explosion_radius);
+    row.handler = rule.handler;
+    row.handler_type_a = rule.reactant_a;
+    return row;
+}
+
+// 규칙을 타입 쌍 순으로 정렬하고 쌍마다 구간을 기록
+// 같은 쌍의 규칙은 등록 순서를 유지 (먼저 등록된 규칙이 먼저 판정됨)
+void ReactionRegistry::compileRules() {
+    compiled.clear();
+    compiled.reserve(reactions.size());
+    
+    for (RuleSpan& span : dispatch) {
+        span.first = 0;
+        span.count = 0;
+        span.min_temperature = 0.0f;
+    }
+    for (int t = 0; t < MATERIAL_COUNT; t++) {
+        partnerMask[t] = 0;
+    }
+    version++;
+    
+    // 쌍마다 규칙 수 세기
+    for (const ReactionRule& rule : reactions) {
+        dispatch[pairKey(rule.reactant_a, rule.reactant_b)].count++;
+    }
+    
+    // 시작 위치 계산 후 규칙 배치
+    int offset = 0;
+    for (RuleSpan& span : dispatch) {
+        span.first = static_cast<uint16_t>(offset);
+        offset += span.count;
+        span.count = 0;
+    }
+    compiled.resize(reactions.size());
+    for (const ReactionRule& rule : reactions) {
+        RuleSpan& span = dispatch[pairKey(rule.reactant_a, rule.reactant_b)];
+        if (span.count == 0 || rule.min_temperature < span.min_temperature) {
+            span.min_temperature = rule.min_temperature;
+        }
+        compiled[span.first + span.count] = compileRule(rule);
+        span.count++;
+        partnerMask[rule.reactant_a] |= 1u << rule.reactant_b;
+        partnerMask[rule.reactant_b] |= 1u << rule.reactant_a;
+    }
 }
 
 // 두 입자 간 반응 확인
 ReactionResult ReactionRegistry::checkReaction(
-    const Particle& p1, const Particle& p2,
-    int x1, int y1, int x2, int y2
+    const CellPlanes& cells, int idx1, int idx2,
+    int x1, int y1, int x2, int y2, Rng& rng
 ) {
     ReactionResult result;
+    int type1 = cells.type[idx1];
+    int type2 = cells.type[idx2];
+    if (type1 >= MATERIAL_COUNT || type2 >= MATERIAL_COUNT) {
+        return result;
+    }
     
-    // 모든 등록된 반응 규칙을 순회
-    for (const ReactionRule& rule : reactions) {
-        // 반응물 타입 매칭 확인
-        bool match = (p1.type == rule.reactant_a && p2.type == rule.reactant_b);
-        
-        if (!match) continue;
-        
-        // 온도 조건 확인 (주석 처리 - 불만 닿아도 반응)
-        // if (p1.temperature < rule.min_temperature && 
-        //     p2.temperature < rule.min_temperature) {
-        //     continue;
-        // }
+    // 타입 쌍의 규칙 구간 조회
+    const RuleSpan& span = dispatch[pairKey(type1, type2)];
+    if (span.count == 0) {
+        return result;
+    }
+    
+    // 온도 조건: 두 입자 모두 구간의 최저 온도보다 차가우면 어떤 규칙도 반응하지 않음
+    float t1 = getTemperature(cells, idx1);
+    float t2 = getTemperature(cells, idx2);
+    if (t1 < span.min_temperature && t2 < span.min_temperature) {
+        return result;
+    }
+    
+    // 셀 1이 쌍의 큰 타입 쪽이면 side = 1 (같은 타입끼리면 0)
+    int side = type1 > type2 ? 1 : 0;
+    
+    const CompiledReaction* row = &compiled[span.first];
+    const CompiledReaction* last = row + span.count;
+    for (; row != last; ++row) {
+        // 규칙별 온도 조건
+        if (t1 < row->min_temperature && t2 < row->min_temperature) {
+            continue;
+        }
         
         // 확률 체크
-        float rand_val = static_cast<float>(rand()) / RAND_MAX;
-        if (rand_val > rule.probability) {
+        if (rng.nextFloat() > row->probability) {
             continue;
         }
         
-        // 반응 핸들러 호출
-        if (rule.handler != nullptr) {
-            result = rule.handler(p1, p2, x1, y1, x2, y2);
+        // 사용자 핸들러 (핸들러의 중심은 항상 reactant_a)
+        // 핸들러가 있을 때만 셀 전체를 읽음
+        if (row->handler != nullptr) {
+            Particle p1 = loadParticle(cells, idx1);
+            Particle p2 = loadParticle(cells, idx2);
+            if (row->handler_type_a == type1) {
+                result = row->handler(p1, p2, x1, y1, x2, y2, rng);
+            } else {
+                result = row->handler(p2, p1, x2, y2, x1, y1, rng);
+                swapRoles(result);
+            }
             
             if (result.occurred) {
                 // 반응 발생 시 즉시 반환
                 return result;
             }
+            continue;
         }
+        
+        // 선언형 결과
+        int other = side ^ 1;
+        result.occurred = true;
+        result.new_type_center = row->product[side];
+        result.new_type_neighbor = row->product[other];
+        result.heat_released = row->heat_released;
+        result.explosion_radius = row->explosion_radius;
+        result.explosion_force = row->explosion_force;
+        result.life_center = row->life_min[side];
+        if (row->life_range[side] > 0) result.life_center += rng.nextInt(row->life_range[side]);
+        result.life_neighbor = row->life_min[other];
+        if (row->life_range[other] > 0) result.life_neighbor += rng.nextInt(row->life_range[other]);
+        return result;
     }
     
     return result; // occurred = false
 }
 
+// 이름이 일치하는 반응의 확률 변경
+int ReactionRegistry::setReactionProbability(const char* name, float probability) {
+    if (name == nullptr)
+        return 0;
+    
+    int changed = 0;
+    for (ReactionRule& rule : reactions) {
+        if (rule.name != nullptr && strcmp(rule.name, name) == 0) {
+            rule.probability = probability;
+            changed++;
+        }
+    }
+    if (changed > 0) {
+        compileRules();
+    }
+    return changed;
+}
+
 // 모든 반응 초기화
 // 각 반응 모듈에서 등록 함수를 호출
 void ReactionRegistry::initializeAllReactions() {
     reactions.clear();
+    compileRules();
     
     // 연소 반응 등록
     registerCombustionReactions(*this);
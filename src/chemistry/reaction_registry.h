@@ -2,45 +2,110 @@
 #define REACTION_REGISTRY_H
 
 #include "reaction_system.h"
+#include "../core/cell_planes.h"
+#include "../material_db.h"
+#include <cstdint>
 #include <vector>
 
+// 이웃 타입 비트마스크가 32비트에 들어가야 함
+static_assert(MATERIAL_COUNT <= 32, "partner mask is 32-bit");
+
+// 반응 규칙 구간 (같은 타입 쌍의 규칙들이 compiled 배열에서 차지하는 범위)
+// 쌍은 (작은 타입, 큰 타입) 순서의 정규 키로 저장
+struct RuleSpan {
+    uint16_t first;                  // compiled 배열의 시작 인덱스
+    uint16_t count;                  // 규칙 수 (0 = 반응 없음)
+    float min_temperature;           // 구간 내 규칙 중 가장 낮은 최소 온도
+};
+
+// 컴파일된 반응 규칙 (디스패치 테이블이 가리키는 평면 행)
+// 결과 필드는 쌍의 [0] = 작은 타입 쪽, [1] = 큰 타입 쪽으로 정렬되어
+// 셀 순서와 관계없이 인덱스 하나로 적용됨
+struct CompiledReaction {
+    float probability;
+    float min_temperature;
+    float heat_released;
+    float explosion_force;
+    int16_t product[2];              // 새 타입 (-1 = 변화 없음)
+    int16_t life_min[2];             // 수명 (-2 = 변화 없음, -1 = 무한)
+    int16_t life_range[2];           // 0보다 크면 수명 = life_min + [0, life_range)
+    uint8_t type_lo;                 // 쌍의 작은 타입
+    uint8_t explosion_radius;
+    ReactionFunc handler;            // nullptr이 아니면 선언형 결과 대신 호출
+    int handler_type_a;              // 핸들러의 중심(reactant_a) 타입
+};
+
 // 반응 레지스트리 클래스
 // 모든 화학 반응을 등록하고 관리
+// 등록된 규칙은 [MATERIAL_COUNT][MATERIAL_COUNT] 디스패치 테이블로 컴파일되어
+// 타입 쌍마다 한 번의 조회로 해당 규칙 구간을 찾음
+// 규칙은 순서 없는 쌍으로 취급하므로 (A, B)만 등록하면 (B, A) 배치에도 적용됨
+// 기본으로는 공유 인스턴스(getInstance)를 사용하며,
+// 월드마다 반응 확률을 다르게 하려면 별도 인스턴스를 만들어 World에 연결
 class ReactionRegistry {
 public:
-    // 싱글톤 인스턴스 획득
+    ReactionRegistry() : dispatch(MATERIAL_COUNT * MATERIAL_COUNT), partnerMask(), version(0) {}
+    
+    // 공유 인스턴스 획득 (World에 레지스트리를 지정하지 않았을 때 사용)
     static ReactionRegistry& getInstance();
     
     // 반응 등록
     void registerReaction(const ReactionRule& rule);
     
-    // 두 입자 간 반응 확인 및 실행
-    // 반환값: 반응이 발생했으면 ReactionResult, 아니면 occurred=false
+    // 두 셀 간 반응 확인 및 실행
+    // 타입 평면만으로 규칙을 찾고, 일치할 때만 Particle 값을 읽어 핸들러에 전달
+    // 셀 순서가 규칙과 반대이면 핸들러 인자를 바꿔 호출하고 결과도 되돌림
+    // 반환값: 반응이 발생했으면 ReactionResult (center = idx1, neighbor = idx2), 아니면 occurred=false
     ReactionResult checkReaction(
-        const Particle& p1, const Particle& p2,
-        int x1, int y1, int x2, int y2
+        const CellPlanes& cells, int idx1, int idx2,
+        int x1, int y1, int x2, int y2, Rng& rng
     );
     
+    // 두 타입 사이에 등록된 반응이 있는지 확인 (확률 판정 없음)
+    // 타입은 0 ~ MATERIAL_COUNT - 1 범위여야 함
+    bool canReact(int type_a, int type_b) const {
+        return dispatch[pairKey(type_a, type_b)].count != 0;
+    }
+    
+    // type_a와 반응할 수 있는 타입 비트마스크 (비트 b = 타입 b, 대칭)
+    // 0이면 어떤 이웃과도 반응하지 않는 물질
+    uint32_t getPartnerMask(int type_a) const { return partnerMask[type_a]; }
+    
+    // 규칙이 바뀔 때마다 증가 (후보 비트맵 갱신 판단용)
+    unsigned getVersion() const { return version; }
+    
     // 모든 반응 초기화 (시뮬레이션 시작 시 호출)
     void initializeAllReactions();
     
     // 등록된 반응 개수 반환
     int getReactionCount() const { return reactions.size(); }
     
+    // 이름이 일치하는 반응의 확률 변경 (파라미터 스윕용)
+    // 반환값: 변경된 규칙 수
+    int setReactionProbability(const char* name, float probability);
+    
 private:
-    // 싱글톤 패턴
-    ReactionRegistry() {}
-    ReactionRegistry(const ReactionRegistry&) = delete;
-    ReactionRegistry& operator=(const ReactionRegistry&) = delete;
+    // 순서 없는 타입 쌍의 정규 키 (min, max)
+    static int pairKey(int type_a, int type_b) {
+        return type_a < type_b ? type_a * MATERIAL_COUNT + type_b
+                               : type_b * MATERIAL_COUNT + type_a;
+    }
     
-    // 반응 규칙 저장소
+    // 등록된 규칙으로 디스패치 테이블을 다시 만듦
+    void compileRules();
+    
+    // 반응 규칙 저장소 (등록 순서)
     std::vector<ReactionRule> reactions;
     
-    // 빠른 조회를 위한 해시 키 생성
-    // key = (type_a << 16) | type_b
-    int makeKey(int type_a, int type_b) const {
-        return (type_a << 16) | type_b;
-    }
+    // 타입 쌍 순으로 정렬된 규칙 (같은 쌍 안에서는 등록 순서 유지)
+    std::vector<CompiledReaction> compiled;
+    
+    // dispatch[pairKey(type_a, type_b)] = 해당 쌍의 규칙 구간
+    std::vector<RuleSpan> dispatch;
+    
+    // partnerMask[type_a] = 반응 가능한 타입 비트마스크
+    uint32_t partnerMask[MATERIAL_COUNT];
+    unsigned version;
 };
 
 #endif // REACTION_REGISTRY_H
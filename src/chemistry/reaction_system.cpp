@@ -1,127 +1,352 @@
 #include "reaction_system.h"
 #include "reaction_registry.h"
 #include "../core/grid.h"
+#include "../core/chunk_manager.h"
+#include "../core/occupancy.h"
 #include "../material_db.h"
 #include <cmath>
-#include <cstdlib>
+#include <vector>
 
-// 랜덤 float 생성 (0.0 ~ 1.0)
-float randomFloat() {
-    return static_cast<float>(rand()) / RAND_MAX;
-}
+// ============================================================================
+// 폭발
+// ============================================================================
 
-// 폭발 효과 적용
-void applyExplosion(int cx, int cy, int radius, float force) {
-    for (int dy = -radius; dy <= radius; dy++) {
-        for (int dx = -radius; dx <= radius; dx++) {
-            float dist = sqrtf(static_cast<float>(dx * dx + dy * dy));
-            if (dist > radius || dist < 0.1f) continue;
-            
-            int x = cx + dx;
-            int y = cy + dy;
-            if (!inBounds(x, y)) continue;
-            
-            int idx = getIndex(x, y);
-            Particle& p = nextGrid[idx];
-            
-            // 거리에 반비례하는 힘 적용
-            float strength = force * (1.0f - dist / radius);
-            
-            // 속도 추가 (방사형)
-            p.vx += (dx / dist) * strength;
-            p.vy += (dy / dist) * strength;
-            
-            // 열 추가
-            p.temperature += strength * 50.0f;
-            
-            // 고체 파괴 (벽 제외)
-            if (p.type == WALL) continue;
-            
-            if (strength > 0.5f && (p.state == STATE_SOLID || p.state == STATE_POWDER)) {
-                // 강한 폭발은 고체를 파괴
-                if (randomFloat() < strength * 0.3f) {
-                    p.type = EMPTY;
-                    p.state = STATE_GAS;
+// 폭발 스텐실의 셀 1개 (감쇠, 방사 방향)
+struct BlastCell {
+    float falloff;                   // 1 - dist / radius
+    float dirX, dirY;                // (dx, dy) / dist
+};
+
+// 스텐실의 행 1개: dx = -halfWidth ~ halfWidth 가 cells[first]부터 연속
+struct BlastRow {
+    int dy;
+    int halfWidth;
+    int first;
+};
+
+// 반경 1 ~ EXPLOSION_MAX_RADIUS의 스텐실 (처음 사용할 때 한 번 계산)
+// 행마다 연속이므로 월드 경계는 셀마다 검사하지 않고 행의 x 범위를 잘라 처리
+// 중심 셀은 감쇠 0 (속도/열/파괴 모두 변화 없음)
+struct BlastStencils {
+    std::vector<BlastCell> cells[EXPLOSION_MAX_RADIUS + 1];
+    std::vector<BlastRow> rows[EXPLOSION_MAX_RADIUS + 1];
+    
+    BlastStencils() {
+        for (int radius = 1; radius <= EXPLOSION_MAX_RADIUS; radius++) {
+            for (int dy = -radius; dy <= radius; dy++) {
+                int halfWidth = 0;
+                while (halfWidth < radius &&
+                       (halfWidth + 1) * (halfWidth + 1) + dy * dy <= radius * radius) {
+                    halfWidth++;
+                }
+                rows[radius].push_back({dy, halfWidth, static_cast<int>(cells[radius].size())});
+                for (int dx = -halfWidth; dx <= halfWidth; dx++) {
+                    float dist = sqrtf(static_cast<float>(dx * dx + dy * dy));
+                    if (dist < 0.1f) {
+                        cells[radius].push_back({0.0f, 0.0f, 0.0f});
+                    } else {
+                        cells[radius].push_back({1.0f - dist / radius, dx / dist, dy / dist});
+                    }
                 }
             }
         }
     }
+};
+
+static const BlastStencils& getBlastStencils() {
+    static const BlastStencils stencils;
+    return stencils;
 }
 
-// 메인 화학 반응 업데이트
-void updateChemistry() {
-    ReactionRegistry& registry = ReactionRegistry::getInstance();
-    
-    // 모든 입자를 순회
-    for (int y = 0; y < HEIGHT; y++) {
-        for (int x = 0; x < WIDTH; x++) {
-            int idx = getIndex(x, y);
-            const Particle& center = grid[idx];
-            
-            // EMPTY는 스킵
-            if (center.type == EMPTY) continue;
-            
-            // 8방향 이웃 체크 (대각선 포함 - 연소 범위 확대)
-            const int dx[] = {0, 1, 1, 1, 0, -1, -1, -1};
-            const int dy[] = {-1, -1, 0, 1, 1, 1, 0, -1};
-            
-            for (int dir = 0; dir < 8; dir++) {
-                int nx = x + dx[dir];
-                int ny = y + dy[dir];
+// 폭발 효과 적용
+void applyExplosion(World& world, Rng& rng, int cx, int cy, int radius, float force) {
+    if (radius <= 0) return;
+    if (radius > EXPLOSION_MAX_RADIUS) radius = EXPLOSION_MAX_RADIUS;
+    
+    const BlastStencils& stencils = getBlastStencils();
+    for (const BlastRow& row : stencils.rows[radius]) {
+        int y = cy + row.dy;
+        if (y < 0 || y >= world.height) continue;
+        
+        // 월드 안에 들어오는 dx 범위
+        int dx0 = -cx > -row.halfWidth ? -cx : -row.halfWidth;
+        int dx1 = world.width - 1 - cx < row.halfWidth ? world.width - 1 - cx : row.halfWidth;
+        const BlastCell* cells = &stencils.cells[radius][row.first + row.halfWidth];
+        
+        // 평면에서 연속인 구간마다 처리 (타일 배치에서는 타일 경계에서 나뉨)
+        forEachRowRun(world, y, cx + dx0, cx + dx1 + 1, [&](int x0, int runIdx, int count) {
+            for (int i = 0; i < count; i++) {
+                const BlastCell& cell = cells[x0 + i - cx];
+                int idx = runIdx + i;
                 
-                if (!inBounds(nx, ny)) continue;
+                // 거리에 반비례하는 힘 적용
+                float strength = force * cell.falloff;
                 
-                int nidx = getIndex(nx, ny);
-                const Particle& neighbor = grid[nidx];
+                // 속도 추가 (방사형)
+                setVx(world.nextGrid, idx, getVx(world.nextGrid, idx) + cell.dirX * strength);
+                setVy(world.nextGrid, idx, getVy(world.nextGrid, idx) + cell.dirY * strength);
                 
-                // 이웃도 EMPTY면 스킵
-                if (neighbor.type == EMPTY) continue;
+                // 열 추가
+                addTemperature(world.nextGrid, idx, strength * 50.0f);
                 
-                // 반응 체크
-                ReactionResult result = registry.checkReaction(
-                    center, neighbor, x, y, nx, ny
-                );
+                // 고체 파괴 (벽 제외)
+                if (world.nextGrid.type[idx] == WALL) continue;
                 
-                if (result.occurred) {
-                    // 중심 입자 변경
-                    if (result.new_type_center >= 0) {
-                        nextGrid[idx].type = result.new_type_center;
-                        const Material& mat = getMaterial(result.new_type_center);
-                        nextGrid[idx].state = mat.default_state;
-                        
-                        // 수명 설정
-                        if (result.life_center >= -1) {
-                            nextGrid[idx].life = result.life_center;
-                        }
-                    }
-                    
-                    // 이웃 입자 변경
-                    if (result.new_type_neighbor >= 0) {
-                        nextGrid[nidx].type = result.new_type_neighbor;
-                        const Material& mat = getMaterial(result.new_type_neighbor);
-                        nextGrid[nidx].state = mat.default_state;
-                        
-                        // 수명 설정
-                        if (result.life_neighbor >= -1) {
-                            nextGrid[nidx].life = result.life_neighbor;
-                        }
-                    }
-                    
-                    // 열 방출
-                    if (result.heat_released != 0.0f) {
-                        nextGrid[idx].temperature += result.heat_released * 0.001f;
-                        nextGrid[nidx].temperature += result.heat_released * 0.001f;
+                int state = world.nextGrid.state[idx];
+                if (strength > 0.5f && (state == STATE_SOLID || state == STATE_POWDER)) {
+                    // 강한 폭발은 고체를 파괴
+                    if (rng.nextFloat() < strength * 0.3f) {
+                        world.nextGrid.type[idx] = EMPTY;
+                        world.nextGrid.state[idx] = STATE_GAS;
+                        updateOccupancy(world, world.nextGrid, x0 + i, y);
                     }
-                    
-                    // 폭발 효과
-                    if (result.explosion_radius > 0) {
-                        applyExplosion(x, y, result.explosion_radius, result.explosion_force);
-                    }
-                    
-                    // 한 번 반응하면 이번 프레임은 종료
-                    break;
+                }
+            }
+        });
+    }
+    
+    // 폭발 범위 전체를 다음 프레임에 깨움
+    markRegionActive(world, cx - radius, cy - radius, cx + radius, cy + radius);
+}
+
+// 폭발을 대기열에 추가
+void queueExplosion(World& world, int cx, int cy, int radius, float force) {
+    if (radius <= 0 || !inBounds(world, cx, cy)) return;
+    
+    int binWidth = (world.width + EXPLOSION_MERGE_CELL - 1) / EXPLOSION_MERGE_CELL;
+    int binHeight = (world.height + EXPLOSION_MERGE_CELL - 1) / EXPLOSION_MERGE_CELL;
+    if (world.explosionBins.size() != static_cast<size_t>(binWidth * binHeight)) {
+        world.explosionBins.assign(binWidth * binHeight, -1);
+    }
+    
+    int& slot = world.explosionBins[(cy / EXPLOSION_MERGE_CELL) * binWidth + cx / EXPLOSION_MERGE_CELL];
+    if (slot < 0) {
+        slot = static_cast<int>(world.explosions.size());
+        world.explosions.push_back({cx, cy, cx, cy, radius, force, cx * force, cy * force});
+        return;
+    }
+    
+    // 같은 칸의 폭발과 합침
+    ExplosionEvent& e = world.explosions[slot];
+    if (cx < e.minX) e.minX = cx;
+    if (cy < e.minY) e.minY = cy;
+    if (cx > e.maxX) e.maxX = cx;
+    if (cy > e.maxY) e.maxY = cy;
+    if (radius > e.radius) e.radius = radius;
+    e.force += force;
+    e.sumX += cx * force;
+    e.sumY += cy * force;
+}
+
+// 대기열의 폭발을 들어온 순서대로 적용
+void flushExplosions(World& world) {
+    if (world.explosions.empty()) return;
+    
+    int binWidth = (world.width + EXPLOSION_MERGE_CELL - 1) / EXPLOSION_MERGE_CELL;
+    Rng rng = worldStreamRng(world, RNG_PASS_EXPLOSION, 0, RNG_ROW_STREAM);
+    
+    for (const ExplosionEvent& e : world.explosions) {
+        // 강도 가중 중심 (강도가 0이면 범위의 가운데)
+        int cx = (e.minX + e.maxX) / 2;
+        int cy = (e.minY + e.maxY) / 2;
+        if (e.force > 0.0f) {
+            cx = static_cast<int>(lroundf(e.sumX / e.force));
+            cy = static_cast<int>(lroundf(e.sumY / e.force));
+        }
+        
+        // 합쳐진 중심들의 범위만큼 반경을 넓힘
+        int spread = e.maxX - e.minX;
+        if (e.maxY - e.minY > spread) spread = e.maxY - e.minY;
+        int radius = e.radius + (spread + 1) / 2;
+        
+        float force = e.force < EXPLOSION_MAX_FORCE ? e.force : EXPLOSION_MAX_FORCE;
+        applyExplosion(world, rng, cx, cy, radius, force);
+        
+        world.explosionBins[(e.minY / EXPLOSION_MERGE_CELL) * binWidth + e.minX / EXPLOSION_MERGE_CELL] = -1;
+    }
+    world.explosions.clear();
+}
+
+// 반쪽 이웃 (동, 남동, 남, 남서)
+// 8방향 이웃 쌍(대각선 포함 - 연소 범위 확대)을 셀마다 이 4방향으로만 세면
+// 순서 없는 쌍 하나를 정확히 한 번씩 방문함
+static const int HALF_NEIGHBOR_COUNT = 4;
+static const int NEIGHBOR_DX[] = {1, 1, 0, -1};
+static const int NEIGHBOR_DY[] = {0, 1, 1, 1};
+
+// ============================================================================
+// 반응 후보 비트맵
+// ----------------------------------------------------------------------------
+// 셀의 타입이 반쪽 이웃 중 하나와 반응 규칙을 가지면 비트 1.
+// 셀이 바뀌면 그 셀과 서/북서/북/북동 이웃의 비트가 바뀔 수 있으므로,
+// 지난 프레임 이후 바뀐 영역(더티 영역)을 1칸 넓혀 다시 계산합니다.
+// ============================================================================
+
+// 셀 (x, y)가 반응 후보인지 계산
+// 월드 밖 이웃은 고스트 WALL이며, WALL은 반응 규칙이 없으므로 후보가 되지 않음
+static bool isReactiveCell(const World& world, const ReactionRegistry& registry, int x, int y) {
+    int idx = getIndex(world, x, y);
+    uint32_t partners = registry.getPartnerMask(world.grid.type[idx]);
+    
+    // 반응 규칙이 없는 물질 (EMPTY, WALL, SAND 등)
+    if (partners == 0) return false;
+    
+    for (int dir = 0; dir < HALF_NEIGHBOR_COUNT; dir++) {
+        int nidx = getIndex(world, x + NEIGHBOR_DX[dir], y + NEIGHBOR_DY[dir]);
+        if (partners & (1u << world.grid.type[nidx])) return true;
+    }
+    return false;
+}
+
+// 사각형 영역의 후보 비트를 다시 계산 (월드 밖은 잘라냄)
+static void refreshReactiveRect(World& world, const ReactionRegistry& registry,
+                                int x0, int y0, int x1, int y1) {
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 >= world.width) x1 = world.width - 1;
+    if (y1 >= world.height) y1 = world.height - 1;
+    
+    for (int y = y0; y <= y1; y++) {
+        uint64_t* row = &world.reactiveCells[y * world.reactiveWordsPerRow];
+        for (int x = x0; x <= x1; x++) {
+            uint64_t bit = 1ull << (x & 63);
+            if (isReactiveCell(world, registry, x, y)) {
+                row[x >> 6] |= bit;
+            } else {
+                row[x >> 6] &= ~bit;
+            }
+        }
+    }
+}
+
+// 화학 패스 시작 시 후보 비트맵을 현재 grid에 맞춤
+static void refreshReactiveCells(World& world, const ReactionRegistry& registry) {
+    // 레지스트리나 규칙이 바뀌었으면 (또는 월드 초기화 후) 전체 재계산
+    if (world.reactiveRegistry != &registry || world.reactiveVersion != registry.getVersion()) {
+        refreshReactiveRect(world, registry, 0, 0, world.width - 1, world.height - 1);
+        world.reactiveRegistry = &registry;
+        world.reactiveVersion = registry.getVersion();
+        return;
+    }
+    
+    // 지난 프레임 이후 바뀐 셀은 지난 프레임 처리 영역 + 이번 프레임 처리 영역 안에 있음
+    // (prepareNextGrid가 다시 맞추는 영역과 같음)
+    for (int i = 0; i < world.chunkCount; i++) {
+        ChunkRect r = unionRect(world.prevChunkRects[i], world.chunkRects[i]);
+        if (isEmptyRect(r)) continue;
+        refreshReactiveRect(world, registry, r.minX - 1, r.minY - 1, r.maxX + 1, r.maxY + 1);
+    }
+}
+
+// 셀 (x, y)와 반쪽 이웃 사이의 반응 처리
+static void reactCell(World& world, ReactionRegistry& registry, Rng& rng, int x, int y) {
+    int idx = getIndex(world, x, y);
+    int centerType = world.grid.type[idx];
+    uint32_t partners = registry.getPartnerMask(centerType);
+    
+    for (int dir = 0; dir < HALF_NEIGHBOR_COUNT; dir++) {
+        int nx = x + NEIGHBOR_DX[dir];
+        int ny = y + NEIGHBOR_DY[dir];
+        
+        // 월드 밖은 고스트 WALL (반응 규칙이 없어 아래에서 스킵)
+        int nidx = getIndex(world, nx, ny);
+        int neighborType = world.grid.type[nidx];
+        
+        // 반응 규칙이 없는 이웃은 스킵
+        if (!(partners & (1u << neighborType))) continue;
+        
+        // 반응 체크
+        ReactionResult result = registry.checkReaction(
+            world.grid, idx, nidx, x, y, nx, ny, rng
+        );
+        
+        if (!result.occurred) {
+            // 반응 가능한 쌍이 확률에 걸려 실패했으면 다음 프레임에 다시 시도
+            if (registry.canReact(centerType, neighborType)) {
+                markChunkActive(world, x, y);
+            }
+            continue;
+        }
+        
+        // 중심 입자 변경
+        if (result.new_type_center >= 0) {
+            world.nextGrid.type[idx] = result.new_type_center;
+            updateOccupancy(world, world.nextGrid, x, y);
+            const Material& mat = getMaterial(result.new_type_center);
+            world.nextGrid.state[idx] = mat.default_state;
+            
+            // 수명 설정
+            if (result.life_center >= -1) {
+                world.nextGrid.life[idx] = result.life_center;
+            }
+        }
+        
+        // 이웃 입자 변경
+        if (result.new_type_neighbor >= 0) {
+            world.nextGrid.type[nidx] = result.new_type_neighbor;
+            updateOccupancy(world, world.nextGrid, nx, ny);
+            const Material& mat = getMaterial(result.new_type_neighbor);
+            world.nextGrid.state[nidx] = mat.default_state;
+            
+            // 수명 설정
+            if (result.life_neighbor >= -1) {
+                world.nextGrid.life[nidx] = result.life_neighbor;
+            }
+        }
+        
+        // 열 방출
+        if (result.heat_released != 0.0f) {
+            addTemperature(world.nextGrid, idx, result.heat_released * 0.001f);
+            addTemperature(world.nextGrid, nidx, result.heat_released * 0.001f);
+        }
+        
+        // 폭발 효과
+        if (result.explosion_radius > 0) {
+            queueExplosion(world, x, y, result.explosion_radius, result.explosion_force);
+        }
+        
+        // 변화가 생긴 두 셀을 다음 프레임에 깨움
+        markChunkActive(world, x, y);
+        markChunkActive(world, nx, ny);
+        
+        // 한 번 반응하면 이번 프레임은 종료
+        break;
+    }
+}
+
+// 메인 화학 반응 업데이트
+void updateChemistry(World& world) {
+    ReactionRegistry& registry = world.reactions ? *world.reactions
+                                                 : ReactionRegistry::getInstance();
+    
+    refreshReactiveCells(world, registry);
+    
+    // 깨어 있는 청크의 더티 영역 중 후보 비트가 선 셀만 청크(타일) 단위로 처리
+    for (int chunkIdx = 0; chunkIdx < world.chunkCount; chunkIdx++) {
+        ChunkRect r;
+        if (!getActiveChunkRect(world, chunkIdx, r)) continue;
+        int cx = chunkIdx % world.chunkWidth;
+        int x0 = r.minX;
+        int x1 = r.maxX;
+        
+        for (int y = r.minY; y <= r.maxY; y++) {
+            const uint64_t* row = &world.reactiveCells[y * world.reactiveWordsPerRow];
+            Rng rng = worldStreamRng(world, RNG_PASS_CHEMISTRY, y, cx);
+            for (int w = x0 >> 6; w <= x1 >> 6; w++) {
+                uint64_t bits = row[w];
+                // 구간 밖의 비트 제거
+                if (w == x0 >> 6) bits &= ~0ull << (x0 & 63);
+                if (w == x1 >> 6) bits &= ~0ull >> (63 - (x1 & 63));
+                
+                while (bits) {
+                    int x = (w << 6) + __builtin_ctzll(bits);
+                    bits &= bits - 1;
+                    reactCell(world, registry, rng, x, y);
                 }
             }
         }
     }
+    
+    // 이번 프레임에 쌓인 폭발을 합쳐서 적용
+    flushExplosions(world);
 }
@@ -2,6 +2,8 @@
 #define REACTION_SYSTEM_H
 
 #include "../particle.h"
+#include "../core/world.h"
+#include "../core/rng.h"
 
 // 반응 결과 구조체
 struct ReactionResult {
@@ -27,32 +29,70 @@ struct ReactionResult {
 };
 
 // 반응 함수 타입 정의
-// 매개변수: (중심 입자, 이웃 입자, 중심 x, 중심 y, 이웃 x, 이웃 y)
+// 매개변수: (중심 입자, 이웃 입자, 중심 x, 중심 y, 이웃 x, 이웃 y, 난수 스트림)
+// 중심은 항상 규칙의 reactant_a, 이웃은 reactant_b (격자에서의 위치와 무관)
 typedef ReactionResult (*ReactionFunc)(
     const Particle& center,
     const Particle& neighbor,
     int cx, int cy,
-    int nx, int ny
+    int nx, int ny,
+    Rng& rng
 );
 
 // 반응 규칙 구조체 (aggregate type for designated initializers)
+// 규칙은 순서 없는 쌍 {A, B}에 한 번만 등록하면 양쪽 배치 모두에 적용됨
+// 결과는 아래 선언형 필드로 기술하며, 필드로 표현할 수 없는 반응만
+// handler를 지정 (handler가 있으면 선언형 필드는 무시)
 struct ReactionRule {
     int reactant_a;                  // 반응물 A 타입
     int reactant_b;                  // 반응물 B 타입
-    ReactionFunc handler;            // 반응 처리 함수
-    float probability;               // 반응 확률 (0.0~1.0)
+    ReactionFunc handler;            // 사용자 반응 함수 (nullptr = 선언형 결과 사용)
+    float probability;               // 반응 확률 (0.0~1.0, 이웃 쌍마다 프레임당 1회 판정)
     float min_temperature;           // 최소 온도 조건 (°C)
     const char* name;                // 반응 이름 (디버깅용)
+    
+    // === 선언형 결과 ===
+    int product_a = -1;              // A의 새 타입 (-1 = 변화 없음)
+    int product_b = -1;              // B의 새 타입 (-1 = 변화 없음)
+    float heat_released = 0.0f;      // 방출된 열 (J) - 양수: 발열, 음수: 흡열
+    int explosion_radius = 0;        // 폭발 반경 (0 = 폭발 없음)
+    float explosion_force = 0.0f;    // 폭발 강도
+    int life_a_min = -2;             // A의 수명 (-2 = 변화 없음, -1 = 무한)
+    int life_a_range = 0;            // 0보다 크면 수명 = life_a_min + [0, life_a_range)
+    int life_b_min = -2;             // B의 수명
+    int life_b_range = 0;
 };
 
+// 셀 방문당 확률 p → 이웃 쌍 확률
+// 반쪽 이웃 순회 전에는 쌍을 양쪽 셀에서 한 번씩 판정했으므로 같은 반응 속도는 1 - (1 - p)^2
+constexpr float pairProbability(float perVisit) {
+    return 1.0f - (1.0f - perVisit) * (1.0f - perVisit);
+}
+
 // 메인 화학 반응 업데이트 함수
 // 모든 입자를 순회하며 이웃과의 반응을 체크
-void updateChemistry();
+void updateChemistry(World& world);
+
+// ============================================================================
+// 폭발
+// ----------------------------------------------------------------------------
+// 반응은 폭발을 바로 적용하지 않고 queueExplosion()으로 대기열에 넣습니다.
+// EXPLOSION_MERGE_CELL x EXPLOSION_MERGE_CELL 칸에 들어온 폭발은 하나로 합쳐지고
+// (강도 합, 강도 가중 중심, 범위를 덮는 반경), 화학 패스 끝의 flushExplosions()에서
+// 미리 계산한 반경별 감쇠 스텐실로 한 번씩 적용됩니다.
+// ============================================================================
+
+const int EXPLOSION_MERGE_CELL = 8;
+const int EXPLOSION_MAX_RADIUS = 12;
+const float EXPLOSION_MAX_FORCE = 12.0f;
+
+// 폭발을 이번 프레임 대기열에 추가 (같은 칸의 폭발과 합쳐짐)
+void queueExplosion(World& world, int cx, int cy, int radius, float force);
 
-// 폭발 효과 적용 헬퍼 함수
-void applyExplosion(int cx, int cy, int radius, float force);
+// 대기열의 폭발을 nextGrid에 적용하고 비움
+void flushExplosions(World& world);
 
-// 랜덤 float 생성 (0.0 ~ 1.0)
-float randomFloat();
+// 폭발 1개를 즉시 적용 (반경은 EXPLOSION_MAX_RADIUS로 제한)
+void applyExplosion(World& world, Rng& rng, int cx, int cy, int radius, float force);
 
 #endif // REACTION_SYSTEM_H
@@ -0,0 +1,61 @@
+#include "background_worker.h"
+
+// pthreads 없이 빌드한 Wasm에서는 스레드를 만들 수 없음
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+#define POWDER_NO_THREADS 1
+#endif
+
+BackgroundWorker::BackgroundWorker() : busy(false), stopping(false) {
+#ifndef POWDER_NO_THREADS
+  thread = std::thread(&BackgroundWorker::workerLoop, this);
+#endif
+}
+
+BackgroundWorker::~BackgroundWorker() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  wakeCondition.notify_all();
+  if (thread.joinable()) {
+    thread.join();
+  }
+}
+
+void BackgroundWorker::workerLoop() {
+  for (;;) {
+    std::function<void()> current;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      wakeCondition.wait(lock, [&] { return stopping || (busy && task); });
+      if (stopping && !busy) return;
+      current.swap(task);
+    }
+
+    current();
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      busy = false;
+    }
+    doneCondition.notify_all();
+  }
+}
+
+void BackgroundWorker::run(std::function<void()> newTask) {
+#ifdef POWDER_NO_THREADS
+  newTask();
+#else
+  std::unique_lock<std::mutex> lock(mutex);
+  doneCondition.wait(lock, [&] { return !busy; });
+  task = std::move(newTask);
+  busy = true;
+  lock.unlock();
+  wakeCondition.notify_one();
+#endif
+}
+
+void BackgroundWorker::wait() {
+  std::unique_lock<std::mutex> lock(mutex);
+  doneCondition.wait(lock, [&] { return !busy; });
+}
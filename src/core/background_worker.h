@@ -0,0 +1,44 @@
+#ifndef BACKGROUND_WORKER_H
+#define BACKGROUND_WORKER_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// ============================================================================
+// 백그라운드 작업 스레드
+// ----------------------------------------------------------------------------
+// 작업 1개를 전용 스레드에서 시작하고 호출한 스레드는 바로 돌아옵니다.
+// 결과가 필요할 때 wait()로 끝나기를 기다립니다 (프레임을 넘기는 패스용).
+// pthreads 없는 Wasm 빌드에서는 run()이 작업을 그 자리에서 실행합니다.
+// ============================================================================
+class BackgroundWorker {
+public:
+  BackgroundWorker();
+  ~BackgroundWorker();
+
+  // task를 작업 스레드에서 시작 (이전 작업이 있으면 끝날 때까지 기다린 뒤)
+  void run(std::function<void()> task);
+
+  // 시작한 작업이 끝날 때까지 대기 (작업이 없으면 바로 반환)
+  void wait();
+
+private:
+  BackgroundWorker(const BackgroundWorker&) = delete;
+  BackgroundWorker& operator=(const BackgroundWorker&) = delete;
+
+  void workerLoop();
+
+  std::thread thread;
+  std::mutex mutex;
+  std::condition_variable wakeCondition;
+  std::condition_variable doneCondition;
+
+  // 현재 작업 (mutex로 보호)
+  std::function<void()> task;
+  bool busy;
+  bool stopping;
+};
+
+#endif // BACKGROUND_WORKER_H
@@ -0,0 +1,148 @@
+#ifndef CELL_PLANES_H
+#define CELL_PLANES_H
+
+#include "../particle.h"
+#include <cstdint>
+#include <cstring>
+
+// ============================================================================
+// SoA 셀 저장소 (압축 인코딩)
+// ----------------------------------------------------------------------------
+// 셀의 각 필드를 별도의 평면(plane) 배열에 저장합니다.
+// 각 패스는 필요한 평면만 읽으므로 (예: 이동은 type/state, 열 전도는
+// temperature) 메모리 대역폭이 줄고, 연속된 평면은 SIMD 처리에 적합합니다.
+//
+// 셀 1개 = 11바이트
+//   type(1) + state(1) + temperature(2) + vx(2) + vy(2) + life(2) + moved_epoch(1)
+//   (POWDER_TEMPERATURE_FP32 빌드에서는 temperature(4)로 13바이트)
+//
+// temperature는 더블 버퍼가 아닙니다. grid와 nextGrid가 같은 온도 평면
+// (World::temperature)을 가리키며, 열 전도 패스가 매 프레임 월드 전체를
+// 갱신합니다. 입자가 이동하면 swapCells()로 온도도 함께 이동합니다.
+//
+// 단일 필드는 평면에 직접 접근하고 (cells.type[idx]),
+// 속도처럼 인코딩된 필드와 여러 평면을 함께 다루는 연산은
+// 아래 헬퍼 함수를 사용합니다.
+// ============================================================================
+
+// 온도 저장 형식
+// 기본은 1/8 °C 단위 int16 고정소수점 (약 -4096 ~ 4095 °C, 최근접 반올림)
+// POWDER_TEMPERATURE_FP32 를 정의하면 float 그대로 저장
+#ifdef POWDER_TEMPERATURE_FP32
+typedef float TemperatureValue;
+const float TEMPERATURE_SCALE = 1.0f;
+
+inline TemperatureValue encodeTemperature(float t) { return t; }
+inline float decodeTemperature(TemperatureValue v) { return v; }
+#else
+typedef int16_t TemperatureValue;
+const float TEMPERATURE_SCALE = 8.0f;
+
+// float → 1/8 °C (범위를 넘으면 포화)
+inline TemperatureValue encodeTemperature(float t) {
+  float scaled = t * TEMPERATURE_SCALE;
+  if (scaled > 32767.0f) scaled = 32767.0f;
+  if (scaled < -32768.0f) scaled = -32768.0f;
+  return static_cast<int16_t>(scaled < 0.0f ? scaled - 0.5f : scaled + 0.5f);
+}
+
+inline float decodeTemperature(TemperatureValue v) {
+  return static_cast<float>(v) * (1.0f / TEMPERATURE_SCALE);
+}
+#endif
+
+struct CellPlanes {
+  uint8_t* type;               // 물질 ID (ParticleType)
+  uint8_t* state;              // 물리 상태 (PhysicalState)
+  TemperatureValue* temperature; // 온도 (인코딩, grid/nextGrid 공유)
+  int16_t* vx;                 // 속도 X (Q8.8 고정소수점)
+  int16_t* vy;                 // 속도 Y (Q8.8 고정소수점)
+  int16_t* life;               // 수명 (-1 = 무한, 0 = 소멸)
+  uint8_t* moved_epoch;        // 마지막으로 이동한 프레임 번호 (하위 8비트)
+  uint64_t* occupancy;         // 점유 비트맵 (core/occupancy.h, 평면과 달리 (x, y) 기준 비트)
+};
+
+// 속도 고정소수점 배율 (1.0 픽셀/프레임 = 256)
+const float VELOCITY_SCALE = 256.0f;
+
+// float → Q8.8 (0 방향으로 버림 → 감쇠를 반복하면 0으로 수렴)
+inline int16_t encodeVelocity(float v) {
+  float scaled = v * VELOCITY_SCALE;
+  if (scaled > 32767.0f) scaled = 32767.0f;
+  if (scaled < -32768.0f) scaled = -32768.0f;
+  return static_cast<int16_t>(scaled);
+}
+
+// Q8.8 → float
+inline float decodeVelocity(int16_t v) {
+  return static_cast<float>(v) * (1.0f / VELOCITY_SCALE);
+}
+
+// 속도 접근 헬퍼
+inline float getVx(const CellPlanes& cells, int idx) { return decodeVelocity(cells.vx[idx]); }
+inline float getVy(const CellPlanes& cells, int idx) { return decodeVelocity(cells.vy[idx]); }
+inline void setVx(CellPlanes& cells, int idx, float v) { cells.vx[idx] = encodeVelocity(v); }
+inline void setVy(CellPlanes& cells, int idx, float v) { cells.vy[idx] = encodeVelocity(v); }
+
+// 온도 접근 헬퍼 (°C)
+inline float getTemperature(const CellPlanes& cells, int idx) {
+  return decodeTemperature(cells.temperature[idx]);
+}
+inline void setTemperature(CellPlanes& cells, int idx, float t) {
+  cells.temperature[idx] = encodeTemperature(t);
+}
+inline void addTemperature(CellPlanes& cells, int idx, float dt) {
+  setTemperature(cells, idx, getTemperature(cells, idx) + dt);
+}
+
+// 두 셀의 모든 필드를 교환 (입자 이동)
+inline void swapCells(CellPlanes& cells, int a, int b) {
+  uint8_t t = cells.type[a]; cells.type[a] = cells.type[b]; cells.type[b] = t;
+  uint8_t s = cells.state[a]; cells.state[a] = cells.state[b]; cells.state[b] = s;
+  TemperatureValue temp = cells.temperature[a];
+  cells.temperature[a] = cells.temperature[b];
+  cells.temperature[b] = temp;
+  int16_t vx = cells.vx[a]; cells.vx[a] = cells.vx[b]; cells.vx[b] = vx;
+  int16_t vy = cells.vy[a]; cells.vy[a] = cells.vy[b]; cells.vy[b] = vy;
+  int16_t life = cells.life[a]; cells.life[a] = cells.life[b]; cells.life[b] = life;
+  uint8_t epoch = cells.moved_epoch[a];
+  cells.moved_epoch[a] = cells.moved_epoch[b];
+  cells.moved_epoch[b] = epoch;
+}
+
+// 셀 1개를 Particle 값으로 읽기 (반응 핸들러 등 AoS 인터페이스용)
+inline Particle loadParticle(const CellPlanes& cells, int idx) {
+  Particle p;
+  p.type = cells.type[idx];
+  p.state = cells.state[idx];
+  p.temperature = getTemperature(cells, idx);
+  p.vx = getVx(cells, idx);
+  p.vy = getVy(cells, idx);
+  p.life = cells.life[idx];
+  return p;
+}
+
+// Particle 값을 셀 1개에 기록 (moved_epoch는 유지)
+inline void storeParticle(CellPlanes& cells, int idx, const Particle& p) {
+  cells.type[idx] = static_cast<uint8_t>(p.type);
+  cells.state[idx] = static_cast<uint8_t>(p.state);
+  setTemperature(cells, idx, p.temperature);
+  setVx(cells, idx, p.vx);
+  setVy(cells, idx, p.vy);
+  cells.life[idx] = static_cast<int16_t>(p.life);
+}
+
+// 연속된 셀 count개를 src → dst로 복사 (모든 평면, 공유 평면은 제외)
+inline void copyCells(CellPlanes& dst, const CellPlanes& src, int idx, int count) {
+  memcpy(&dst.type[idx], &src.type[idx], count * sizeof(*dst.type));
+  memcpy(&dst.state[idx], &src.state[idx], count * sizeof(*dst.state));
+  if (dst.temperature != src.temperature) {
+    memcpy(&dst.temperature[idx], &src.temperature[idx], count * sizeof(*dst.temperature));
+  }
+  memcpy(&dst.vx[idx], &src.vx[idx], count * sizeof(*dst.vx));
+  memcpy(&dst.vy[idx], &src.vy[idx], count * sizeof(*dst.vy));
+  memcpy(&dst.life[idx], &src.life[idx], count * sizeof(*dst.life));
+  memcpy(&dst.moved_epoch[idx], &src.moved_epoch[idx], count * sizeof(*dst.moved_epoch));
+}
+
+#endif // CELL_PLANES_H
@@ -0,0 +1,82 @@
+#include "chunk_manager.h"
+
+// 빈 사각형
+static inline ChunkRect emptyRect(const World& world) {
+  return ChunkRect{world.width, world.height, -1, -1};
+}
+
+void markRegionActive(const World& world, ChunkRect* rects, int x0, int y0, int x1, int y1) {
+  // 월드 범위로 잘라냄
+  if (x0 < 0) x0 = 0;
+  if (y0 < 0) y0 = 0;
+  if (x1 > world.width - 1) x1 = world.width - 1;
+  if (y1 > world.height - 1) y1 = world.height - 1;
+  if (x0 > x1 || y0 > y1)
+    return;
+
+  int cx0 = x0 / CHUNK_SIZE;
+  int cy0 = y0 / CHUNK_SIZE;
+  int cx1 = x1 / CHUNK_SIZE;
+  int cy1 = y1 / CHUNK_SIZE;
+
+  for (int cy = cy0; cy <= cy1; cy++) {
+    int chunkY0 = cy * CHUNK_SIZE;
+    int chunkY1 = chunkY0 + CHUNK_SIZE - 1;
+    int ry0 = y0 > chunkY0 ? y0 : chunkY0;
+    int ry1 = y1 < chunkY1 ? y1 : chunkY1;
+
+    for (int cx = cx0; cx <= cx1; cx++) {
+      int chunkX0 = cx * CHUNK_SIZE;
+      int chunkX1 = chunkX0 + CHUNK_SIZE - 1;
+      int rx0 = x0 > chunkX0 ? x0 : chunkX0;
+      int rx1 = x1 < chunkX1 ? x1 : chunkX1;
+
+      ChunkRect& r = rects[cy * world.chunkWidth + cx];
+      if (rx0 < r.minX) r.minX = rx0;
+      if (ry0 < r.minY) r.minY = ry0;
+      if (rx1 > r.maxX) r.maxX = rx1;
+      if (ry1 > r.maxY) r.maxY = ry1;
+    }
+  }
+}
+
+void wakeAllChunks(World& world) {
+  for (int i = 0; i < world.chunkCount; i++) {
+    world.activeChunks[i] = false;
+    world.chunkRects[i] = emptyRect(world);
+    world.prevChunkRects[i] = emptyRect(world);
+    world.nextChunkRects[i] = emptyRect(world);
+  }
+  markRegionActive(world, 0, 0, world.width - 1, world.height - 1);
+}
+
+void beginChunkFrame(World& world) {
+  for (int i = 0; i < world.chunkCount; i++) {
+    world.prevChunkRects[i] = world.chunkRects[i];
+    world.chunkRects[i] = world.nextChunkRects[i];
+    world.activeChunks[i] = !isEmptyRect(world.chunkRects[i]);
+    world.nextChunkRects[i] = emptyRect(world);
+  }
+}
+
+void clearChunkRects(const World& world, ChunkRect* rects, int count) {
+  for (int i = 0; i < count; i++) {
+    rects[i] = emptyRect(world);
+  }
+}
+
+void mergeChunkRects(World& world, ChunkRect* rects) {
+  for (int i = 0; i < world.chunkCount; i++) {
+    if (isEmptyRect(rects[i])) continue;
+    world.nextChunkRects[i] = unionRect(world.nextChunkRects[i], rects[i]);
+    rects[i] = emptyRect(world);
+  }
+}
+
+int getActiveChunkCount(const World& world) {
+  int count = 0;
+  for (int i = 0; i < world.chunkCount; i++) {
+    if (world.activeChunks[i]) count++;
+  }
+  return count;
+}
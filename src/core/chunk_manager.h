@@ -0,0 +1,117 @@
+#ifndef CHUNK_MANAGER_H
+#define CHUNK_MANAGER_H
+
+#include "types.h"
+#include "world.h"
+
+// ============================================================================
+// Active Chunks 스케줄러
+// ----------------------------------------------------------------------------
+// 월드를 CHUNK_SIZE x CHUNK_SIZE 청크로 나누고, 각 청크마다 더티 사각형을
+// 유지합니다. 이번 프레임에 변화가 생긴 셀(과 주변 1칸)은 다음 프레임의
+// 처리 영역으로 기록되며, 변화가 없는 청크는 잠들어 패스에서 건너뜁니다.
+// 주변 1칸이 청크 경계를 넘으면 이웃 청크도 함께 깨어납니다.
+// 청크 테이블은 World에 있으며 월드 크기에 맞춰 할당됩니다.
+// ============================================================================
+
+// 헬퍼 함수: 빈 사각형인지 확인
+inline bool isEmptyRect(const ChunkRect& r) {
+  return r.minX > r.maxX;
+}
+
+// 헬퍼 함수: 두 사각형을 모두 덮는 사각형
+inline ChunkRect unionRect(const ChunkRect& a, const ChunkRect& b) {
+  return ChunkRect{
+    a.minX < b.minX ? a.minX : b.minX,
+    a.minY < b.minY ? a.minY : b.minY,
+    a.maxX > b.maxX ? a.maxX : b.maxX,
+    a.maxY > b.maxY ? a.maxY : b.maxY
+  };
+}
+
+// 헬퍼 함수: 청크 인덱스 계산
+inline int getChunkIndex(const World& world, int x, int y) {
+  int cx = x / CHUNK_SIZE;
+  int cy = y / CHUNK_SIZE;
+  if (cx < 0 || cx >= world.chunkWidth || cy < 0 || cy >= world.chunkHeight)
+    return -1;
+  return cy * world.chunkWidth + cx;
+}
+
+// 영역 [x0, x1] x [y0, y1] 을 rects 테이블에 기록 (월드 밖은 잘라냄)
+// rects는 청크 수만큼의 더티 사각형 테이블 (보통 world.nextChunkRects)
+void markRegionActive(const World& world, ChunkRect* rects, int x0, int y0, int x1, int y1);
+
+// 영역 [x0, x1] x [y0, y1] 을 다음 프레임에 깨움
+inline void markRegionActive(World& world, int x0, int y0, int x1, int y1) {
+  markRegionActive(world, world.nextChunkRects.data(), x0, y0, x1, y1);
+}
+
+// 셀 (x, y)와 주변 1칸을 rects 테이블에 기록
+// 병렬 패스는 작업자별 테이블에 기록한 뒤 mergeChunkRects()로 합침
+inline void markChunkActive(const World& world, ChunkRect* rects, int x, int y) {
+  int lx = x % CHUNK_SIZE;
+  int ly = y % CHUNK_SIZE;
+
+  // 주변 1칸이 청크 경계를 넘으면 이웃 청크까지 처리
+  if (x <= 0 || y <= 0 || lx == 0 || ly == 0 ||
+      lx == CHUNK_SIZE - 1 || ly == CHUNK_SIZE - 1 ||
+      x >= world.width - 1 || y >= world.height - 1) {
+    markRegionActive(world, rects, x - 1, y - 1, x + 1, y + 1);
+    return;
+  }
+
+  ChunkRect& r = rects[(y / CHUNK_SIZE) * world.chunkWidth + x / CHUNK_SIZE];
+  if (x - 1 < r.minX) r.minX = x - 1;
+  if (y - 1 < r.minY) r.minY = y - 1;
+  if (x + 1 > r.maxX) r.maxX = x + 1;
+  if (y + 1 > r.maxY) r.maxY = y + 1;
+}
+
+// 셀 (x, y)와 주변 1칸을 다음 프레임에 깨움
+inline void markChunkActive(World& world, int x, int y) {
+  markChunkActive(world, world.nextChunkRects.data(), x, y);
+}
+
+// 행 y에서 청크 열 cx의 처리 구간 [x0, x1]을 구함
+// 청크가 잠들어 있거나 해당 행이 더티 영역 밖이면 false
+inline bool getChunkRowSpan(const World& world, int cx, int y, int& x0, int& x1) {
+  int chunkIdx = (y / CHUNK_SIZE) * world.chunkWidth + cx;
+  if (!world.activeChunks[chunkIdx])
+    return false;
+
+  const ChunkRect& r = world.chunkRects[chunkIdx];
+  if (y < r.minY || y > r.maxY)
+    return false;
+
+  x0 = r.minX;
+  x1 = r.maxX;
+  return true;
+}
+
+// 청크 chunkIdx의 이번 프레임 처리 영역을 구함 (잠들어 있으면 false)
+// 셀마다 자기 셀과 이웃만 다루는 패스는 청크(타일) 단위로 훑어 이웃 행을 캐시에 둠
+inline bool getActiveChunkRect(const World& world, int chunkIdx, ChunkRect& r) {
+  if (!world.activeChunks[chunkIdx])
+    return false;
+
+  r = world.chunkRects[chunkIdx];
+  return !isEmptyRect(r);
+}
+
+// 모든 청크를 전체 영역으로 깨움 (초기화 시 사용)
+void wakeAllChunks(World& world);
+
+// 프레임 시작: 지난 프레임에 기록된 영역을 이번 프레임 스케줄로 넘김
+void beginChunkFrame(World& world);
+
+// 빈 더티 사각형 테이블 count개로 초기화
+void clearChunkRects(const World& world, ChunkRect* rects, int count);
+
+// rects 테이블을 다음 프레임 테이블에 합치고 rects는 비움
+void mergeChunkRects(World& world, ChunkRect* rects);
+
+// 이번 프레임에 깨어 있는 청크 수 (디버깅/통계용)
+int getActiveChunkCount(const World& world);
+
+#endif // CHUNK_MANAGER_H
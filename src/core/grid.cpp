@@ -1,97 +1,169 @@
 #include "grid.h"
+#include "occupancy.h"
 #include "../material_db.h"
 #include <cstring>
-#include <cstdlib>
 
-// 그리드 데이터 정의
-Particle grid[GRID_SIZE];
-Particle nextGrid[GRID_SIZE];
-int renderBuffer[GRID_SIZE];
-bool activeChunks[CHUNK_COUNT];
+// 고스트를 포함한 moved_epoch 평면 전체를 0으로
+static void clearMovedEpoch(World& world, CellPlanes& planes) {
+  memset(planes.moved_epoch - world.planeOrigin, 0, world.planeSize * sizeof(*planes.moved_epoch));
+}
 
 // 그리드 초기화
-void initGrid() {
-  for (int i = 0; i < GRID_SIZE; i++) {
-    grid[i] = Particle(); // 기본 생성자 사용
-    nextGrid[i] = grid[i];
-    renderBuffer[i] = EMPTY;
+void initGrid(World& world) {
+  world.frameEpoch = 1;
+  
+  // 월드 안은 빈 셀, 나머지(테두리 고스트, 타일 배치의 남는 칸)는 WALL
+  // (어떤 패스도 월드 밖에 쓰지 않으므로 그대로 유지됨)
+  const Particle empty; // 기본 생성자 사용
+  Particle wall;
+  wall.type = WALL;
+  wall.state = STATE_SOLID;
+  for (int idx = -world.planeOrigin; idx < world.planeSize - world.planeOrigin; idx++) {
+    storeParticle(world.grid, idx, wall);
+    storeParticle(world.nextGrid, idx, wall);
+  }
+  for (int y = 0; y < world.height; y++) {
+    for (int x = 0; x < world.width; x++) {
+      int idx = getIndex(world, x, y);
+      storeParticle(world.grid, idx, empty);
+      storeParticle(world.nextGrid, idx, empty);
+    }
+  }
+  for (int i = 0; i < world.size; i++) {
+    world.renderBuffer[i] = EMPTY;
+  }
+  clearMovedEpoch(world, world.grid);
+  clearMovedEpoch(world, world.nextGrid);
+  
+  // 첫 프레임은 모든 청크를 처리하고 반응 후보도 전부 다시 계산
+  wakeAllChunks(world);
+  world.reactiveRegistry = nullptr;
+  resetOccupancy(world, world.grid);
+  resetOccupancy(world, world.nextGrid);
+}
+
+// 사각형 영역을 grid → nextGrid로 복사
+// (청크 1개 안의 영역이므로 행마다 평면에서 연속)
+static void copyForward(World& world, const ChunkRect& r) {
+  int count = r.maxX - r.minX + 1;
+  for (int y = r.minY; y <= r.maxY; y++) {
+    copyCells(world.nextGrid, world.grid, getIndex(world, r.minX, y), count);
+  }
+}
+
+// 프레임 준비
+void prepareNextGrid(World& world) {
+  // 난수 스트림 키가 되는 프레임 수
+  world.frame++;
+  
+  // 프레임 번호 증가 (8비트이므로 256프레임마다 스탬프를 한 번 초기화)
+  if (++world.frameEpoch == 0) {
+    clearMovedEpoch(world, world.grid);
+    clearMovedEpoch(world, world.nextGrid);
+    world.frameEpoch = 1;
   }
   
-  // 모든 청크 활성화
-  for (int i = 0; i < CHUNK_COUNT; i++) {
-    activeChunks[i] = true;
+  // 교체 후 nextGrid는 두 프레임 전 상태이므로,
+  // 지난 프레임에 처리/기록된 영역과 이번 프레임 영역만 다시 맞춤 (점유 비트맵 포함)
+  for (int i = 0; i < world.chunkCount; i++) {
+    ChunkRect r = unionRect(world.prevChunkRects[i], world.chunkRects[i]);
+    if (isEmptyRect(r)) continue;
+    copyForward(world, r);
+    copyOccupancy(world, world.nextGrid, world.grid, r);
   }
 }
 
-// 렌더 버퍼 업데이트
-void updateRenderBuffer() {
-  for (int i = 0; i < GRID_SIZE; i++) {
-    renderBuffer[i] = grid[i].type;
+// 평면 포인터 교체
+void swapGrids(World& world) {
+  CellPlanes temp = world.grid;
+  world.grid = world.nextGrid;
+  world.nextGrid = temp;
+}
+
+// 렌더 버퍼 업데이트 (렌더 버퍼는 고스트 없이 width x height)
+void updateRenderBuffer(World& world) {
+  // 이번 프레임에 처리한 영역 + 다음 프레임에 깨운 영역 밖은 변하지 않음
+  for (int i = 0; i < world.chunkCount; i++) {
+    ChunkRect r = unionRect(world.chunkRects[i], world.nextChunkRects[i]);
+    if (isEmptyRect(r)) continue;
+    
+    for (int y = r.minY; y <= r.maxY; y++) {
+      int* out = &world.renderBuffer[y * world.width + r.minX];
+      const uint8_t* type = &world.grid.type[getIndex(world, r.minX, y)];
+      for (int i = 0; i <= r.maxX - r.minX; i++) {
+        out[i] = type[i];
+      }
+    }
   }
 }
 
 // 입자 추가
-void addParticle(int x, int y, int type) {
-  if (!inBounds(x, y))
+void addParticle(World& world, int x, int y, int type) {
+  if (!inBounds(world, x, y))
+    return;
+
+  // 물질 DB에 없는 타입은 무시 (반응 디스패치 테이블 범위 보호)
+  if (type < 0 || type >= MATERIAL_COUNT)
     return;
 
-  int idx = getIndex(x, y);
+  int idx = getIndex(world, x, y);
+  CellPlanes& grid = world.grid;
   
   // EMPTY가 아니면 덮어쓰지 않음 (기존 물질 보호)
-  if (grid[idx].type != EMPTY)
+  if (grid.type[idx] != EMPTY)
     return;
   
-  grid[idx].type = type;
+  grid.type[idx] = type;
+  updateOccupancy(world, grid, x, y);
   
   const Material& mat = getMaterial(type);
-  grid[idx].state = mat.default_state;
+  grid.state[idx] = mat.default_state;
   
   // 타입에 따라 초기 온도 및 수명 설정
   switch (type) {
   case FIRE:
-    grid[idx].temperature = 150.0f;
-    grid[idx].life = 30 + rand() % 30; // 30-60 프레임 (0.5-1초)
+    setTemperature(grid, idx, 150.0f);
+    grid.life[idx] = 30 + world.rng.nextInt(30); // 30-60 프레임 (0.5-1초)
     break;
   case ICE:
-    grid[idx].temperature = -10.0f;
-    grid[idx].life = -1; // 무한
+    setTemperature(grid, idx, -10.0f);
+    grid.life[idx] = -1; // 무한
     break;
   case STEAM:
-    grid[idx].temperature = 110.0f;
-    grid[idx].life = -1; // 무한
+    setTemperature(grid, idx, 110.0f);
+    grid.life[idx] = -1; // 무한
     break;
   case OXYGEN:
   case HYDROGEN:
   case STEAM_OIL:
   case CO2:
-    grid[idx].temperature = 20.0f;
-    grid[idx].life = -1; // 무한
+    setTemperature(grid, idx, 20.0f);
+    grid.life[idx] = -1; // 무한
     break;
   case WOOD:
   case IRON:
-    grid[idx].temperature = 20.0f;
-    grid[idx].life = -1; // 무한
+    setTemperature(grid, idx, 20.0f);
+    grid.life[idx] = -1; // 무한
     break;
   case LITHIUM:
   case SODIUM:
-    grid[idx].temperature = 20.0f;
-    grid[idx].life = -1; // 무한
+    setTemperature(grid, idx, 20.0f);
+    grid.life[idx] = -1; // 무한
     break;
   case OIL:
-    grid[idx].temperature = 20.0f;
-    grid[idx].life = -1; // 무한
+    setTemperature(grid, idx, 20.0f);
+    grid.life[idx] = -1; // 무한
     break;
   default:
-    grid[idx].temperature = 20.0f;
-    grid[idx].life = -1; // 무한
+    setTemperature(grid, idx, 20.0f);
+    grid.life[idx] = -1; // 무한
     break;
   }
   
   // 속도 초기화
-  grid[idx].vx = 0.0f;
-  grid[idx].vy = 0.0f;
-  grid[idx].latent_heat_storage = 0.0f;
+  grid.vx[idx] = 0;
+  grid.vy[idx] = 0;
   
   // 청크 활성화
-  markChunkActive(x, y);
+  markChunkActive(world, x, y);
 }
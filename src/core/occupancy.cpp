@@ -0,0 +1,66 @@
+#include "occupancy.h"
+#include <cstring>
+
+// 행 y의 [x0, x1] 비트를 type 평면으로 다시 계산
+static void rebuildOccupancyRow(const World& world, CellPlanes& cells, const uint8_t* rank,
+                                int y, int x0, int x1) {
+  uint64_t* row = getOccupancyRow(world, cells, y);
+  forEachRowRun(world, y, x0, x1 + 1, [&](int sx, int idx, int count) {
+    const uint8_t* types = &cells.type[idx];
+    int i = 0;
+    // 워드 1개에 걸친 칸씩 평면 값을 모아 한 번에 기록
+    while (i < count) {
+      int bit = sx + i + OCCUPANCY_PAD;
+      int lane = bit & 63;
+      int n = count - i < 64 - lane ? count - i : 64 - lane;
+
+      // 순위 바이트를 8칸씩 묶어 평면마다 곱셈 한 번으로 8비트를 모음
+      // (바이트 k의 비트 p → 결과의 비트 k, 리틀 엔디언 기준)
+      uint8_t ranks[64 + 8] = {};
+      for (int k = 0; k < n; k++) ranks[k] = rank[types[i + k]];
+      uint64_t planes[MATERIAL_RANK_BITS] = {};
+      for (int k = 0; k < n; k += 8) {
+        uint64_t v;
+        memcpy(&v, &ranks[k], sizeof(v));
+        for (int p = 0; p < MATERIAL_RANK_BITS; p++) {
+          uint64_t gathered = (((v >> p) & 0x0101010101010101ull) * 0x0102040810204080ull) >> 56;
+          planes[p] |= gathered << (lane + k);
+        }
+      }
+
+      uint64_t mask = (n == 64 ? ~0ull : ((1ull << n) - 1)) << lane;
+      uint64_t* words = &row[(bit >> 6) * MATERIAL_RANK_BITS];
+      for (int p = 0; p < MATERIAL_RANK_BITS; p++) words[p] = (words[p] & ~mask) | (planes[p] & mask);
+      i += n;
+    }
+  });
+}
+
+void resetOccupancy(const World& world, CellPlanes& cells) {
+  size_t count = static_cast<size_t>(world.occupancyWordsPerRow) * world.height * MATERIAL_RANK_BITS;
+  for (size_t i = 0; i < count; i++) cells.occupancy[i] = ~0ull;
+
+  const uint8_t* rank = getMaterialTable().rank;
+  for (int y = 0; y < world.height; y++) {
+    rebuildOccupancyRow(world, cells, rank, y, 0, world.width - 1);
+  }
+}
+
+void copyOccupancy(const World& world, CellPlanes& dst, const CellPlanes& src, const ChunkRect& r) {
+  int first = r.minX + OCCUPANCY_PAD;
+  int last = r.maxX + OCCUPANCY_PAD;
+  for (int y = r.minY; y <= r.maxY; y++) {
+    uint64_t* to = getOccupancyRow(world, dst, y);
+    const uint64_t* from = getOccupancyRow(world, src, y);
+    // 청크 폭 구간이므로 워드 1 ~ 2개
+    for (int w = first >> 6; w <= last >> 6; w++) {
+      int lo = w == (first >> 6) ? (first & 63) : 0;
+      int hi = w == (last >> 6) ? (last & 63) : 63;
+      uint64_t mask = (hi - lo == 63 ? ~0ull : ((1ull << (hi - lo + 1)) - 1)) << lo;
+      for (int p = 0; p < MATERIAL_RANK_BITS; p++) {
+        size_t i = static_cast<size_t>(w) * MATERIAL_RANK_BITS + p;
+        to[i] = (to[i] & ~mask) | (from[i] & mask);
+      }
+    }
+  }
+}
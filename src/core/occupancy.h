@@ -0,0 +1,131 @@
+#ifndef OCCUPANCY_H
+#define OCCUPANCY_H
+
+#include "world.h"
+#include "../materials/material_table.h"
+
+// ============================================================================
+// 점유 비트맵
+// ----------------------------------------------------------------------------
+// 셀마다 이동 순위(MaterialTable::rank)를 비트 평면 MATERIAL_RANK_BITS개로 나눠
+// 담은 행 우선 비트맵입니다 (64셀 = 워드 1개, 평면 값이 모두 0이면 빈 셀).
+// 입자는 자기보다 순위가 낮은 셀로만 이동할 수 있으므로, 수평 확산이 찾는
+// "reach칸 안에서 가장 가까운 이동 가능 칸"을 워드 연산 몇 번과 ctz/clz로 구합니다.
+// (이동 판정은 grid 기준이므로 검색도 grid의 비트맵을 읽음)
+//
+// 셀 평면처럼 버퍼마다 하나씩 있고 (CellPlanes::occupancy) 평면 포인터와 함께 교체됩니다.
+// type 평면에 쓰는 곳은 모두 같은 셀의 비트맵도 갱신해야 합니다
+// (이동은 swapOccupancy(), 그 밖에는 updateOccupancy()).
+//
+// 행마다 왼쪽에 패딩 워드 1개, 오른쪽에 2개가 있고 월드 밖 칸은 고체 순위(WALL)입니다.
+// 셀 (x, y)는 행 y의 비트 x + OCCUPANCY_PAD이고, 워드 w의 평면 p는
+// [(y * occupancyWordsPerRow + w) * MATERIAL_RANK_BITS + p]에 있습니다.
+// ============================================================================
+
+// 왼쪽 패딩 비트 수
+const int OCCUPANCY_PAD = 64;
+
+// 행 y의 첫 워드 (평면 0)
+inline uint64_t* getOccupancyRow(const World& world, const CellPlanes& cells, int y) {
+  return cells.occupancy + static_cast<size_t>(y) * world.occupancyWordsPerRow * MATERIAL_RANK_BITS;
+}
+
+// 비트맵 전체를 cells의 type 평면으로 다시 계산 (월드 밖 패딩은 WALL)
+void resetOccupancy(const World& world, CellPlanes& cells);
+
+// 사각형 영역의 비트맵을 src → dst로 복사 (prepareNextGrid의 평면 복사와 같은 영역)
+void copyOccupancy(const World& world, CellPlanes& dst, const CellPlanes& src, const ChunkRect& r);
+
+// 셀 (x, y)의 비트를 type 평면 값에 맞춤 (순차 패스 전용)
+inline void updateOccupancy(const World& world, CellPlanes& cells, int x, int y) {
+  int bit = x + OCCUPANCY_PAD;
+  uint64_t* words = getOccupancyRow(world, cells, y) + (bit >> 6) * MATERIAL_RANK_BITS;
+  uint64_t mask = 1ull << (bit & 63);
+  int rank = getMaterialTable().rank[cells.type[getIndex(world, x, y)]];
+  for (int p = 0; p < MATERIAL_RANK_BITS; p++) {
+    words[p] = ((rank >> p) & 1) ? (words[p] | mask) : (words[p] & ~mask);
+  }
+}
+
+// 두 셀의 비트 교환 (swapCells와 함께 호출), diff = 두 셀 순위의 XOR
+// shared: 병렬 이동처럼 다른 작업자가 같은 워드의 다른 비트를 고칠 수 있으면
+// 원자적 XOR로 뒤집음 (XOR는 순서와 무관)
+inline void swapOccupancy(const World& world, CellPlanes& cells, int ax, int ay, int bx, int by,
+                          int diff, bool shared) {
+  int bitA = ax + OCCUPANCY_PAD;
+  int bitB = bx + OCCUPANCY_PAD;
+  uint64_t* wordsA = getOccupancyRow(world, cells, ay) + (bitA >> 6) * MATERIAL_RANK_BITS;
+  uint64_t* wordsB = getOccupancyRow(world, cells, by) + (bitB >> 6) * MATERIAL_RANK_BITS;
+  uint64_t maskA = 1ull << (bitA & 63);
+  uint64_t maskB = 1ull << (bitB & 63);
+  // 순위가 다른 평면만 두 셀 모두 뒤집음
+  while (diff != 0) {
+    int p = __builtin_ctz(diff);
+    diff &= diff - 1;
+    if (shared) {
+      __atomic_fetch_xor(&wordsA[p], maskA, __ATOMIC_RELAXED);
+      __atomic_fetch_xor(&wordsB[p], maskB, __ATOMIC_RELAXED);
+    } else {
+      wordsA[p] ^= maskA;
+      wordsB[p] ^= maskB;
+    }
+  }
+}
+
+// 행 y의 [x0, x0 + count) 중 빈 셀이 아닌 칸의 비트 (비트 i = 칸 x0 + i, count <= 64)
+// 패스가 빈 칸을 건너뛸 때 사용. 병렬 이동 중 다른 작업자가 같은 워드의 다른 비트를
+// 고칠 수 있으므로 원자적으로 읽음
+inline uint64_t loadOccupiedBits(const World& world, const CellPlanes& cells, int y, int x0, int count) {
+  int first = x0 + OCCUPANCY_PAD;
+  uint64_t* words = getOccupancyRow(world, cells, y) + (first >> 6) * MATERIAL_RANK_BITS;
+  int shift = first & 63;
+  uint64_t occupied = 0;
+  for (int p = 0; p < MATERIAL_RANK_BITS; p++) {
+    uint64_t v = __atomic_load_n(&words[p], __ATOMIC_RELAXED) >> shift;
+    if (shift != 0) v |= __atomic_load_n(&words[MATERIAL_RANK_BITS + p], __ATOMIC_RELAXED) << (64 - shift);
+    occupied |= v;
+  }
+  return count >= 64 ? occupied : occupied & ((1ull << count) - 1);
+}
+
+// 행 y에서 비트 first부터 64칸을 워드 1개로 읽은 평면들 중 순위 < rank인 칸의 비트
+inline uint64_t loadLowerRankBits(const World& world, const CellPlanes& cells, int y, int first, int rank) {
+  const uint64_t* words = getOccupancyRow(world, cells, y) + (first >> 6) * MATERIAL_RANK_BITS;
+  int shift = first & 63;
+
+  // 상위 비트부터 비교: lower = 이미 작다고 정해진 칸, equal = 지금까지 같은 칸
+  uint64_t lower = 0;
+  uint64_t equal = ~0ull;
+  for (int p = MATERIAL_RANK_BITS - 1; p >= 0; p--) {
+    uint64_t v = words[p] >> shift;
+    if (shift != 0) v |= words[MATERIAL_RANK_BITS + p] << (64 - shift);
+    if ((rank >> p) & 1) {
+      lower |= equal & ~v;
+      equal &= v;
+    } else {
+      equal &= ~v;
+    }
+  }
+  return lower;
+}
+
+// 행 y의 [x - reach, x + reach] 중 rank 입자가 이동할 수 있는 칸의 비트
+// (비트 i = 칸 x - reach + i, 가운데 x 자신은 제외, reach는 GHOST_X 이하)
+// grid는 이동 패스 동안 바뀌지 않으므로 양쪽 확산이 창 하나를 같이 씀
+inline uint64_t loadSlideWindow(const World& world, const CellPlanes& cells, int x, int y,
+                                int reach, int rank) {
+  uint64_t window = (1ull << (2 * reach + 1)) - 1;
+  return loadLowerRankBits(world, cells, y, x - reach + OCCUPANCY_PAD, rank) & window & ~(1ull << reach);
+}
+
+// 창에서 dir 방향으로 가장 가까운 칸까지의 거리 (없으면 0)
+inline int findNearestInWindow(uint64_t bits, int reach, int dir) {
+  if (dir > 0) {
+    uint64_t right = bits >> (reach + 1);
+    return right ? __builtin_ctzll(right) + 1 : 0;
+  }
+  uint64_t left = bits & ((1ull << reach) - 1);
+  return left ? reach - (63 - __builtin_clzll(left)) : 0;
+}
+
+#endif // OCCUPANCY_H
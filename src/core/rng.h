@@ -0,0 +1,86 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <cstdint>
+
+// ============================================================================
+// 난수 생성기 (PCG32)
+// ----------------------------------------------------------------------------
+// rand() 대신 사용하는 시드 고정 난수 생성기입니다.
+// 64비트 상태 + 스트림 선택자(inc)로 구성되며, 같은 시드라도 스트림이 다르면
+// 서로 독립된 수열을 냅니다. 패스는 (월드 시드, 프레임, 패스, 청크 행)마다
+// 스트림을 따로 만들어 쓰므로, 처리 순서나 스레드 수와 무관하게
+// 같은 시드 → 같은 프레임이 재현됩니다.
+// ============================================================================
+
+// 64비트 해시 (SplitMix64 최종 단계)
+inline uint64_t mixBits(uint64_t x) {
+  x += 0x9E3779B97F4A7C15ull;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+  return x ^ (x >> 31);
+}
+
+class Rng {
+public:
+  Rng() : state(0), inc(1) {}
+  Rng(uint64_t seed, uint64_t stream) { reseed(seed, stream); }
+
+  void reseed(uint64_t seed, uint64_t stream) {
+    state = 0;
+    inc = (stream << 1) | 1u;
+    next();
+    state += seed;
+    next();
+  }
+
+  // 32비트 난수
+  uint32_t next() {
+    uint64_t old = state;
+    state = old * 6364136223846793005ull + inc;
+    uint32_t xorshifted = static_cast<uint32_t>(((old >> 18) ^ old) >> 27);
+    uint32_t rot = static_cast<uint32_t>(old >> 59);
+    return (xorshifted >> rot) | (xorshifted << ((-rot) & 31));
+  }
+
+  // [0, 1) 범위 float
+  float nextFloat() {
+    return (next() >> 8) * (1.0f / 16777216.0f);
+  }
+
+  // [0, n) 범위 정수 (n > 0)
+  int nextInt(int n) {
+    return static_cast<int>((static_cast<uint64_t>(next()) * static_cast<uint32_t>(n)) >> 32);
+  }
+
+  // -1 또는 1
+  int nextSign() {
+    return (next() & 1u) ? 1 : -1;
+  }
+
+private:
+  uint64_t state;
+  uint64_t inc;
+};
+
+// 스트림을 나누는 패스 ID
+enum RngPass {
+  RNG_PASS_CHEMISTRY = 1,
+  RNG_PASS_FORCES = 2,
+  RNG_PASS_LIFE = 3,
+  RNG_PASS_MOVEMENT = 4,
+  RNG_PASS_EXPLOSION = 5
+};
+
+// 행 단위 결정(순회 방향 등)에 쓰는 청크 열 번호
+const uint32_t RNG_ROW_STREAM = 0xFFFF;
+
+// (월드 시드, 프레임, 패스, 행, 청크 열)로부터 독립 스트림 생성
+inline Rng makeStreamRng(uint64_t seed, uint32_t frame, uint32_t pass, int y, uint32_t cx) {
+  uint64_t key = mixBits(seed ^ (static_cast<uint64_t>(frame) << 8 | pass));
+  uint64_t stream = (static_cast<uint64_t>(static_cast<uint32_t>(y)) << 16) | cx;
+  // 스트림 번호도 시드에 섞어 인접 스트림 간 상관을 없앰
+  return Rng(mixBits(key ^ stream), stream);
+}
+
+#endif // RNG_H
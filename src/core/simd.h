@@ -0,0 +1,129 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+// ============================================================================
+// float SIMD 래퍼
+// ----------------------------------------------------------------------------
+// 평면 단위 커널(열 전도 등)이 같은 코드로 여러 명령어 집합을 쓰도록
+// 최소한의 연산만 감쌉니다. 컴파일러가 정의하는 매크로로 선택됩니다.
+// simdLoadI16/simdStoreI16은 int16 평면(고정소수점 온도 등)과 float 레인
+// 사이를 변환합니다 (저장 시 최근접 반올림 후 int16 범위로 포화).
+//   AVX      (__AVX__)            : 8 레인
+//   SSE2     (__SSE2__, x86-64)   : 4 레인
+//   simd128  (__wasm_simd128__)   : 4 레인 (emcc -msimd128)
+//   그 외                         : 1 레인 (스칼라)
+// ============================================================================
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define POWDER_SIMD_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define POWDER_SIMD_SSE2 1
+#elif defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define POWDER_SIMD_WASM 1
+#endif
+
+#include <cstdint>
+
+#if defined(POWDER_SIMD_AVX)
+
+typedef __m256 SimdF32;
+const int SIMD_F32_LANES = 8;
+
+inline SimdF32 simdLoad(const float* p) { return _mm256_loadu_ps(p); }
+inline void simdStore(float* p, SimdF32 v) { _mm256_storeu_ps(p, v); }
+inline SimdF32 simdSplat(float v) { return _mm256_set1_ps(v); }
+inline SimdF32 simdAdd(SimdF32 a, SimdF32 b) { return _mm256_add_ps(a, b); }
+inline SimdF32 simdSub(SimdF32 a, SimdF32 b) { return _mm256_sub_ps(a, b); }
+inline SimdF32 simdMul(SimdF32 a, SimdF32 b) { return _mm256_mul_ps(a, b); }
+inline SimdF32 simdDiv(SimdF32 a, SimdF32 b) { return _mm256_div_ps(a, b); }
+inline SimdF32 simdAbs(SimdF32 v) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), v); }
+// a > b 인 레인의 비트 (레인 i = 비트 i)
+inline int simdMaskGreater(SimdF32 a, SimdF32 b) { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_GT_OQ)); }
+
+inline SimdF32 simdLoadI16(const int16_t* p) {
+  __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+  __m128i lo = _mm_cvtepi16_epi32(v);
+  __m128i hi = _mm_cvtepi16_epi32(_mm_srli_si128(v, 8));
+  return _mm256_cvtepi32_ps(_mm256_insertf128_si256(_mm256_castsi128_si256(lo), hi, 1));
+}
+inline void simdStoreI16(int16_t* p, SimdF32 v) {
+  v = _mm256_min_ps(_mm256_max_ps(v, _mm256_set1_ps(-32768.0f)), _mm256_set1_ps(32767.0f));
+  __m256i i = _mm256_cvtps_epi32(v);
+  __m128i packed = _mm_packs_epi32(_mm256_castsi256_si128(i), _mm256_extractf128_si256(i, 1));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(p), packed);
+}
+
+#elif defined(POWDER_SIMD_SSE2)
+
+typedef __m128 SimdF32;
+const int SIMD_F32_LANES = 4;
+
+inline SimdF32 simdLoad(const float* p) { return _mm_loadu_ps(p); }
+inline void simdStore(float* p, SimdF32 v) { _mm_storeu_ps(p, v); }
+inline SimdF32 simdSplat(float v) { return _mm_set1_ps(v); }
+inline SimdF32 simdAdd(SimdF32 a, SimdF32 b) { return _mm_add_ps(a, b); }
+inline SimdF32 simdSub(SimdF32 a, SimdF32 b) { return _mm_sub_ps(a, b); }
+inline SimdF32 simdMul(SimdF32 a, SimdF32 b) { return _mm_mul_ps(a, b); }
+inline SimdF32 simdDiv(SimdF32 a, SimdF32 b) { return _mm_div_ps(a, b); }
+inline SimdF32 simdAbs(SimdF32 v) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), v); }
+inline int simdMaskGreater(SimdF32 a, SimdF32 b) { return _mm_movemask_ps(_mm_cmpgt_ps(a, b)); }
+
+inline SimdF32 simdLoadI16(const int16_t* p) {
+  __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p));
+  return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16));
+}
+inline void simdStoreI16(int16_t* p, SimdF32 v) {
+  v = _mm_min_ps(_mm_max_ps(v, _mm_set1_ps(-32768.0f)), _mm_set1_ps(32767.0f));
+  __m128i i = _mm_cvtps_epi32(v);
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_packs_epi32(i, i));
+}
+
+#elif defined(POWDER_SIMD_WASM)
+
+typedef v128_t SimdF32;
+const int SIMD_F32_LANES = 4;
+
+inline SimdF32 simdLoad(const float* p) { return wasm_v128_load(p); }
+inline void simdStore(float* p, SimdF32 v) { wasm_v128_store(p, v); }
+inline SimdF32 simdSplat(float v) { return wasm_f32x4_splat(v); }
+inline SimdF32 simdAdd(SimdF32 a, SimdF32 b) { return wasm_f32x4_add(a, b); }
+inline SimdF32 simdSub(SimdF32 a, SimdF32 b) { return wasm_f32x4_sub(a, b); }
+inline SimdF32 simdMul(SimdF32 a, SimdF32 b) { return wasm_f32x4_mul(a, b); }
+inline SimdF32 simdDiv(SimdF32 a, SimdF32 b) { return wasm_f32x4_div(a, b); }
+inline SimdF32 simdAbs(SimdF32 v) { return wasm_f32x4_abs(v); }
+inline int simdMaskGreater(SimdF32 a, SimdF32 b) { return wasm_i32x4_bitmask(wasm_f32x4_gt(a, b)); }
+
+inline SimdF32 simdLoadI16(const int16_t* p) { return wasm_f32x4_convert_i32x4(wasm_i32x4_load16x4(p)); }
+inline void simdStoreI16(int16_t* p, SimdF32 v) {
+  v128_t i = wasm_i32x4_trunc_sat_f32x4(wasm_f32x4_nearest(v));
+  wasm_v128_store64_lane(p, wasm_i16x8_narrow_i32x4(i, i), 0);
+}
+
+#else
+
+typedef float SimdF32;
+const int SIMD_F32_LANES = 1;
+
+inline SimdF32 simdLoad(const float* p) { return *p; }
+inline void simdStore(float* p, SimdF32 v) { *p = v; }
+inline SimdF32 simdSplat(float v) { return v; }
+inline SimdF32 simdAdd(SimdF32 a, SimdF32 b) { return a + b; }
+inline SimdF32 simdSub(SimdF32 a, SimdF32 b) { return a - b; }
+inline SimdF32 simdMul(SimdF32 a, SimdF32 b) { return a * b; }
+inline SimdF32 simdDiv(SimdF32 a, SimdF32 b) { return a / b; }
+inline SimdF32 simdAbs(SimdF32 v) { return v < 0.0f ? -v : v; }
+inline int simdMaskGreater(SimdF32 a, SimdF32 b) { return a > b ? 1 : 0; }
+
+inline SimdF32 simdLoadI16(const int16_t* p) { return static_cast<float>(*p); }
+inline void simdStoreI16(int16_t* p, SimdF32 v) {
+  if (v > 32767.0f) v = 32767.0f;
+  if (v < -32768.0f) v = -32768.0f;
+  *p = static_cast<int16_t>(v < 0.0f ? v - 0.5f : v + 0.5f);
+}
+
+#endif
+
+#endif // SIMD_H
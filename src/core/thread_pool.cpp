@@ -0,0 +1,84 @@
+#include "thread_pool.h"
+
+// pthreads 없이 빌드한 Wasm에서는 스레드를 만들 수 없음
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+#define POWDER_NO_THREADS 1
+#endif
+
+ThreadPool::ThreadPool(int threadCount)
+  : job(nullptr), jobTaskCount(0), nextTask(0),
+    busyWorkers(0), generation(0), stopping(false) {
+#ifdef POWDER_NO_THREADS
+  threadCount = 1;
+#endif
+  for (int i = 1; i < threadCount; i++) {
+    threads.emplace_back(&ThreadPool::workerLoop, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  wakeCondition.notify_all();
+  for (std::thread& t : threads) {
+    t.join();
+  }
+}
+
+// 남은 작업을 하나씩 가져가 실행
+void ThreadPool::runTasks(int workerIndex) {
+  for (;;) {
+    int task = nextTask.fetch_add(1, std::memory_order_relaxed);
+    if (task >= jobTaskCount) break;
+    (*job)(task, workerIndex);
+  }
+}
+
+void ThreadPool::workerLoop(int workerIndex) {
+  unsigned seenGeneration = 0;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      wakeCondition.wait(lock, [&] { return stopping || generation != seenGeneration; });
+      if (stopping) return;
+      seenGeneration = generation;
+    }
+
+    runTasks(workerIndex);
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (--busyWorkers == 0) doneCondition.notify_one();
+    }
+  }
+}
+
+void ThreadPool::parallelFor(int taskCount, const std::function<void(int, int)>& fn) {
+  if (taskCount <= 0)
+    return;
+
+  // 작업이 1개이거나 작업자가 없으면 바로 실행
+  if (taskCount == 1 || threads.empty()) {
+    for (int i = 0; i < taskCount; i++) fn(i, 0);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    job = &fn;
+    jobTaskCount = taskCount;
+    nextTask.store(0, std::memory_order_relaxed);
+    busyWorkers = static_cast<int>(threads.size());
+    generation++;
+  }
+  wakeCondition.notify_all();
+
+  // 호출 스레드도 작업자 0번으로 참여
+  runTasks(0);
+
+  std::unique_lock<std::mutex> lock(mutex);
+  doneCondition.wait(lock, [&] { return busyWorkers == 0; });
+  job = nullptr;
+}
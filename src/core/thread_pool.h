@@ -0,0 +1,53 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ============================================================================
+// 스레드 풀
+// ----------------------------------------------------------------------------
+// parallelFor()로 작업 N개를 스레드들에 나눠 실행하고 모두 끝날 때까지
+// 기다립니다. 호출한 스레드도 작업자 0번으로 참여합니다.
+// 네이티브는 std::thread, Emscripten은 -pthread 빌드에서 pthreads를 사용하며,
+// pthreads 없는 Wasm 빌드에서는 작업자 없이 호출 스레드에서 순차 실행합니다.
+// ============================================================================
+class ThreadPool {
+public:
+  // threadCount: 호출 스레드를 포함한 전체 스레드 수 (1 이하이면 순차 실행)
+  explicit ThreadPool(int threadCount);
+  ~ThreadPool();
+
+  // 전체 스레드 수 (작업자 번호는 0 ~ getThreadCount() - 1)
+  int getThreadCount() const { return static_cast<int>(threads.size()) + 1; }
+
+  // fn(taskIndex, workerIndex)를 taskIndex = 0 ~ taskCount - 1 에 대해 실행
+  // 모든 작업이 끝나야 반환 (작업 사이의 순서는 보장하지 않음)
+  void parallelFor(int taskCount, const std::function<void(int, int)>& fn);
+
+private:
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  void workerLoop(int workerIndex);
+  void runTasks(int workerIndex);
+
+  std::vector<std::thread> threads;
+  std::mutex mutex;
+  std::condition_variable wakeCondition;
+  std::condition_variable doneCondition;
+
+  // 현재 작업 (mutex로 보호, generation이 바뀌면 새 작업)
+  const std::function<void(int, int)>* job;
+  int jobTaskCount;
+  std::atomic<int> nextTask;
+  int busyWorkers;
+  unsigned generation;
+  bool stopping;
+};
+
+#endif // THREAD_POOL_H
@@ -1,16 +1,44 @@
 #ifndef TYPES_H
 #define TYPES_H
 
-// 그리드 크기
-const int WIDTH = 400;
-const int HEIGHT = 300;
-const int GRID_SIZE = WIDTH * HEIGHT;
+// 기본 그리드 크기 (init()에 크기를 지정하지 않았을 때)
+// 실제 크기는 World가 런타임에 정함 (core/world.h)
+// 빌드 시 -DDEFAULT_WORLD_WIDTH=... 로 바꿀 수 있음
+#ifndef DEFAULT_WORLD_WIDTH
+#define DEFAULT_WORLD_WIDTH 400
+#endif
+#ifndef DEFAULT_WORLD_HEIGHT
+#define DEFAULT_WORLD_HEIGHT 300
+#endif
 
-// Active Chunks 시스템 (현재 비활성화)
+const int DEFAULT_WIDTH = DEFAULT_WORLD_WIDTH;
+const int DEFAULT_HEIGHT = DEFAULT_WORLD_HEIGHT;
+
+// Active Chunks 시스템 (core/chunk_manager.h)
 const int CHUNK_SIZE = 16;
-const int CHUNK_WIDTH = (WIDTH + CHUNK_SIZE - 1) / CHUNK_SIZE;
-const int CHUNK_HEIGHT = (HEIGHT + CHUNK_SIZE - 1) / CHUNK_SIZE;
-const int CHUNK_COUNT = CHUNK_WIDTH * CHUNK_HEIGHT;
+const int CHUNK_SHIFT = 4;                        // log2(CHUNK_SIZE)
+const int CHUNK_CELLS = CHUNK_SIZE * CHUNK_SIZE;  // 청크 1개의 셀 수 (타일 배치의 타일 크기)
+static_assert((1 << CHUNK_SHIFT) == CHUNK_SIZE, "CHUNK_SHIFT must match CHUNK_SIZE");
+
+// 셀 평면 테두리의 고스트 셀 폭 (core/world.h, 모두 WALL)
+// 이웃 검사가 월드 밖을 가리켜도 평면 안의 WALL을 읽으므로 범위 검사가 필요 없음
+// 가로는 이동 패스의 최대 수평 확산 거리, 세로는 위아래 1칸 이웃
+const int GHOST_X = 10;
+const int GHOST_Y = 1;
+
+// 청크 더티 영역 (양 끝 포함, minX > maxX 이면 비어있음)
+struct ChunkRect {
+  int minX, minY, maxX, maxY;
+};
+
+// 폭발 대기열 항목 (chemistry/reaction_system.h)
+// 같은 병합 칸에 들어온 폭발은 하나로 합쳐짐
+struct ExplosionEvent {
+  int minX, minY, maxX, maxY;  // 합쳐진 폭발 중심들의 범위
+  int radius;                  // 가장 큰 반경
+  float force;                 // 강도 합
+  float sumX, sumY;            // 강도 가중 중심 합
+};
 
 // 물리 상수
 const float GRAVITY = 0.3f;
@@ -21,5 +49,19 @@ const float MAX_VELOCITY_X = 3.0f;
 // 열 전도 상수
 const float HEAT_CONDUCTION_BASE = 0.05f;
 const float HEAT_CHANGE_THRESHOLD = 0.1f;
+// 열전도율이 이 값(W/(m·K))을 넘는 물질(금속 등)은 비례해서 빠르게 전도
+const float HEAT_CONDUCTIVITY_REFERENCE = 1.0f;
+// 명시적 풀이의 1회 전도율 상한 (넘으면 진동하므로 잘라냄)
+const float HEAT_EXPLICIT_MAX_RATE = 0.5f;
+
+// 열 전도 풀이 방식
+enum HeatSolver {
+  HEAT_SOLVER_EXPLICIT = 0,    // 주변 4칸 평균 쪽으로 이동 (빠름, 전도율 상한 있음)
+  HEAT_SOLVER_ADI = 1,         // 행/열 방향 암시적 풀이 (큰 시간 간격에서도 안정)
+  HEAT_SOLVER_MULTIRES = 2     // 공기는 블록 단위, 물질 셀만 셀 단위 (빈 공간이 많을 때 빠름)
+};
+
+// 다중 해상도 풀이에서 공기 온도 블록 1개의 크기 (셀 단위, CHUNK_SIZE의 약수)
+const int THERMAL_BLOCK_SIZE = 4;
 
 #endif // TYPES_H
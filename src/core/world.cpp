@@ -0,0 +1,110 @@
+#include "world.h"
+#include "grid.h"
+#include "background_worker.h"
+#include "occupancy.h"
+#include "../material_db.h"
+
+// 물질 ID는 type 평면(uint8_t)에 들어가야 함
+static_assert(MATERIAL_COUNT <= 256, "type plane is 8-bit");
+
+// 저장소를 셀 count개 크기로 할당 (점유 비트맵은 워드 occupancyWords개)
+static void resizeStorage(CellStorage& s, int count, size_t occupancyWords) {
+  s.type.resize(count);
+  s.state.resize(count);
+  s.vx.resize(count);
+  s.vy.resize(count);
+  s.life.resize(count);
+  s.moved_epoch.resize(count);
+  s.occupancy.resize(occupancyWords);
+}
+
+// 평면 포인터는 저장소의 (0, 0) 셀 위치를 가리킴 (앞쪽은 고스트 셀)
+static CellPlanes planesOf(CellStorage& s, TemperatureValue* temperature, int origin) {
+  return CellPlanes{
+    s.type.data() + origin, s.state.data() + origin, temperature + origin,
+    s.vx.data() + origin, s.vy.data() + origin, s.life.data() + origin,
+    s.moved_epoch.data() + origin, s.occupancy.data()
+  };
+}
+
+World::~World() {
+  if (thermalPending) thermalWorker->wait();
+}
+
+void initWorld(World& world, int width, int height) {
+  // 작업 스레드가 옛 버퍼를 쓰는 중이면 끝난 뒤 결과는 버림
+  if (world.thermalPending) {
+    world.thermalWorker->wait();
+    world.thermalPending = false;
+  }
+  world.thermalChunkRects.clear();
+
+  if (width <= 0 || height <= 0) {
+    width = DEFAULT_WIDTH;
+    height = DEFAULT_HEIGHT;
+  }
+
+  world.width = width;
+  world.height = height;
+  world.size = width * height;
+  world.chunkWidth = (width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+  world.chunkHeight = (height + CHUNK_SIZE - 1) / CHUNK_SIZE;
+  world.chunkCount = world.chunkWidth * world.chunkHeight;
+#ifdef POWDER_TILED_LAYOUT
+  // 청크 타일 사방에 고스트 타일 1겹 (타일 (-1, -1)이 저장소 맨 앞)
+  world.stride = (world.chunkWidth + 2) * CHUNK_CELLS;
+  world.planeSize = world.stride * (world.chunkHeight + 2);
+  world.planeOrigin = world.stride + CHUNK_CELLS;
+#else
+  world.stride = width + 2 * GHOST_X;
+  world.planeSize = world.stride * (height + 2 * GHOST_Y);
+  world.planeOrigin = GHOST_Y * world.stride + GHOST_X;
+#endif
+
+  // 셀 평면 (고스트 포함)
+  // 점유 비트맵: 왼쪽 패딩 1 + 월드 폭 + 오른쪽 패딩 2 워드 (reach칸 창을 두 워드로 읽어도 행 안)
+  world.occupancyWordsPerRow = (width + 63) / 64 + 3;
+  size_t occupancyWords = static_cast<size_t>(world.occupancyWordsPerRow) * height * MATERIAL_RANK_BITS;
+  resizeStorage(world.storageA, world.planeSize, occupancyWords);
+  resizeStorage(world.storageB, world.planeSize, occupancyWords);
+  world.temperature.resize(world.planeSize);
+  world.grid = planesOf(world.storageA, world.temperature.data(), world.planeOrigin);
+  world.nextGrid = planesOf(world.storageB, world.temperature.data(), world.planeOrigin);
+  world.renderBuffer.resize(world.size);
+
+  // 열 전도 작업 버퍼
+  world.thermalScratch.resize((width + 2) * 3);
+  world.thermalRate.resize(width);
+  world.thermalBlocks.clear();      // 다중 해상도 풀이는 다음 풀이 때 전체를 다시 읽음
+  world.thermalExplicitFallback = false;
+
+  // 청크 테이블
+  world.activeChunks.resize(world.chunkCount);
+  world.chunkRects.resize(world.chunkCount);
+  world.prevChunkRects.resize(world.chunkCount);
+  world.nextChunkRects.resize(world.chunkCount);
+  world.workerChunkRects.clear();   // 병렬 이동 시 작업자 수에 맞춰 다시 할당
+  world.thermalChunkDirty.assign(world.chunkCount, 1);
+  world.thermalChunkSolve.assign(world.chunkCount, 0);
+  world.thermalChunkStep = 0.0f;    // 첫 명시적 풀이는 전체를 풂
+
+  // 반응 후보 비트맵 (initGrid에서 전체 재계산 표시)
+  world.reactiveWordsPerRow = (width + 63) / 64;
+  world.reactiveCells.resize(world.reactiveWordsPerRow * height);
+
+  // 폭발 대기열 (병합 칸은 첫 폭발 때 크기에 맞춰 할당)
+  world.explosions.clear();
+  world.explosionBins.clear();
+
+  // 난수 스트림 재시작 (시드는 유지)
+  world.frame = 0;
+  world.rng = Rng(world.seed, 0);
+
+  // 내용 초기화
+  initGrid(world);
+}
+
+void setWorldSeed(World& world, uint64_t seed) {
+  world.seed = seed;
+  world.rng = Rng(seed, 0);
+}
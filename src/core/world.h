@@ -0,0 +1,232 @@
+#ifndef WORLD_H
+#define WORLD_H
+
+#include "types.h"
+#include "cell_planes.h"
+#include "rng.h"
+#include <cstdint>
+#include <vector>
+
+class ReactionRegistry;
+class ThreadPool;
+class BackgroundWorker;
+
+// 시드를 지정하지 않았을 때의 월드 시드
+const uint64_t DEFAULT_SEED = 0x5EED;
+
+// ============================================================================
+// World - 시뮬레이션 월드 1개의 전체 상태
+// ----------------------------------------------------------------------------
+// 크기는 initWorld()에서 런타임에 정해지며, 셀 평면과 청크 테이블은
+// 모두 그 크기에 맞춰 힙에 할당됩니다.
+// 셀 평면은 좌우 GHOST_X, 위아래 GHOST_Y칸의 WALL 고스트 셀로 둘러싸여 있고,
+// 평면 포인터는 (0, 0) 셀을 가리키므로 getIndex()는 월드 밖 좌표(고스트)에도 유효합니다.
+// 셀 배치는 빌드 옵션으로 고릅니다.
+//   기본                 : 행 우선 (행 간격 stride)
+//   POWDER_TILED_LAYOUT  : 타일 우선 (청크 1개 = CHUNK_SIZE x CHUNK_SIZE 셀이 연속,
+//                          타일 안은 행 우선, 테두리는 타일 1겹이 고스트)
+// 어느 배치든 한 행에서 청크 폭 구간 안의 셀은 연속이므로, 행 단위로 평면을 훑는
+// 코드는 forEachRowRun()으로 연속 구간마다 처리합니다.
+// 평면 포인터(grid/nextGrid)가 내부 저장소를 가리키므로 복사할 수 없습니다.
+// 전역 상태가 없으므로 한 프로세스에서 여러 월드를 독립적으로 돌릴 수 있습니다.
+// ============================================================================
+
+// 버퍼 1개 분량의 평면 저장소 (온도는 두 버퍼가 공유하므로 World에 따로 둠)
+struct CellStorage {
+  std::vector<uint8_t> type;
+  std::vector<uint8_t> state;
+  std::vector<int16_t> vx;
+  std::vector<int16_t> vy;
+  std::vector<int16_t> life;
+  std::vector<uint8_t> moved_epoch;
+  std::vector<uint64_t> occupancy;
+};
+
+// 다중 해상도 열 전도의 공기 블록 (THERMAL_BLOCK_SIZE x THERMAL_BLOCK_SIZE 셀)
+struct ThermalBlock {
+  float air;                   // 블록 안 공기 셀의 온도 (모두 같은 값으로 취급)
+  float heat;                  // 이번 풀이에서 공기 셀 온도 합의 변화량
+  TemperatureValue stored;     // 셀 평면의 공기 셀에 마지막으로 기록한 값
+  uint8_t airCells;            // 공기(EMPTY) 셀 수
+  uint8_t matterCells;         // 물질 셀 수
+  uint8_t linkRight;           // 오른쪽 블록과 맞닿은 공기-공기 셀 쌍 수
+  uint8_t linkDown;            // 아래쪽 블록과 맞닿은 공기-공기 셀 쌍 수
+  uint8_t dirty;               // 셀 평면에서 다시 읽어야 함 (다른 패스가 바꿨을 수 있음)
+};
+
+// 다중 해상도 열 전도의 블록 행 상태 (조용한 행은 블록을 훑지 않고 건너뜀)
+struct ThermalBlockRow {
+  int first;                   // 물질 셀이 있는 첫 블록 (없으면 last < first)
+  int last;                    // 물질 셀이 있는 마지막 블록
+  int x0;                      // 이번 풀이에서 행 버퍼에 채울 셀 범위 [x0, x1)
+  int x1;
+  uint8_t dirty;               // 다시 읽어야 하는 블록이 있음
+  uint8_t settled;             // 아래 행과의 공기-공기 교환까지 모두 멈춘 뒤 두 행의 공기가 그대로임
+  uint8_t pending;             // 이번 풀이에서 열을 받은 블록이 있을 수 있음
+};
+
+struct World {
+  // === 크기 ===
+  int width;
+  int height;
+  int size;                    // width * height
+  int stride;                  // 행 우선: 행 간격 (width + 2 * GHOST_X), 타일: 타일 행 간격 (셀 수)
+  int planeSize;               // 고스트를 포함한 셀 평면 1개의 셀 수
+  int planeOrigin;             // 저장소 안에서 (0, 0) 셀의 위치
+  int chunkWidth;
+  int chunkHeight;
+  int chunkCount;
+
+  // === 셀 데이터 (SoA 평면, 더블 버퍼) ===
+  // grid는 이번 프레임의 읽기 전용 상태, nextGrid는 다음 상태를 기록하는 버퍼
+  // 프레임이 끝나면 평면 포인터만 교체하며, 두 버퍼의 차이는 더티 영역에만 존재
+  CellPlanes grid;
+  CellPlanes nextGrid;
+  std::vector<int> renderBuffer;   // 고스트 없이 width x height (JS가 읽음)
+
+  // 현재 프레임 번호 (moved_epoch 비교용 8비트 값, 0은 사용하지 않음)
+  uint8_t frameEpoch;
+
+  // === 난수 (core/rng.h) ===
+  uint64_t seed;               // 월드 시드
+  uint32_t frame;              // initWorld 이후 진행한 프레임 수 (스트림 키)
+  Rng rng;                     // 프레임 밖에서 쓰는 순차 스트림 (입자 추가 등)
+
+  // === 청크 스케줄 (core/chunk_manager.h) ===
+  std::vector<uint8_t> activeChunks;       // 이번 프레임에 처리할 청크
+  std::vector<ChunkRect> chunkRects;       // 이번 프레임 처리 영역
+  std::vector<ChunkRect> prevChunkRects;   // 지난 프레임 처리 영역
+  std::vector<ChunkRect> nextChunkRects;   // 다음 프레임에 깨울 영역
+
+  // === 화학 반응 규칙 ===
+  // nullptr이면 공유 레지스트리(ReactionRegistry::getInstance()) 사용
+  ReactionRegistry* reactions;
+
+  // === 반응 후보 셀 (chemistry/reaction_system.h) ===
+  // 반응 가능한 이웃과 맞닿은 셀의 비트맵 (행 우선, 행마다 64비트 워드 reactiveWordsPerRow개)
+  // 화학 패스가 시작할 때 지난 프레임의 더티 영역만 다시 계산
+  std::vector<uint64_t> reactiveCells;
+  int reactiveWordsPerRow;
+  const ReactionRegistry* reactiveRegistry;  // 비트맵을 만든 레지스트리 (nullptr = 전체 재계산)
+  unsigned reactiveVersion;                  // 그 레지스트리의 규칙 버전
+
+  // === 점유 비트맵 (core/occupancy.h) ===
+  // 비트맵 자체는 버퍼마다 CellStorage에 있음 (행마다 64비트 워드 occupancyWordsPerRow개 x 평면 수)
+  int occupancyWordsPerRow;
+
+  // === 폭발 대기열 (chemistry/reaction_system.h) ===
+  // 화학 패스 중 쌓였다가 패스 끝에 한 번에 적용
+  std::vector<ExplosionEvent> explosions;
+  std::vector<int> explosionBins;          // 병합 칸 → explosions 인덱스 (-1 = 없음)
+
+  // === 병렬 처리 (core/thread_pool.h) ===
+  // nullptr이면 모든 패스를 순차 실행 (여러 월드가 같은 풀을 공유해도 됨)
+  ThreadPool* threadPool;
+  std::vector<ChunkRect> workerChunkRects;  // 작업자별 깨울 영역 테이블
+
+  // === 평면 저장소 (grid/nextGrid가 가리킴) ===
+  CellStorage storageA;
+  CellStorage storageB;
+
+  // === 온도 (physics/heat_conduction.h) ===
+  std::vector<TemperatureValue> temperature;  // grid/nextGrid가 함께 가리키는 온도 평면
+  std::vector<float> thermalScratch;   // 디코딩한 고스트 셀 포함 행 버퍼 3개 ((width + 2) x 3)
+  std::vector<float> thermalRate;      // 행 1개의 셀별 전도율 (암시적 풀이에서는 소거 계수)
+  std::vector<uint8_t> thermalChunkDirty;  // 청크별: 지난 명시적 풀이 이후 온도/type이 바뀌었을 수 있음
+  std::vector<uint8_t> thermalChunkSolve;  // 명시적 풀이가 이번에 풀 청크 (풀이 안에서만 사용)
+  float thermalChunkStep;              // 표시가 유효한 명시적 풀이의 dt (0 = 다음 풀이는 전체를 풂)
+  HeatSolver thermalSolver;            // 풀이 방식 (기본 명시적)
+  int thermalInterval;                 // 몇 프레임마다 풀지 (한 번에 그만큼의 시간을 진행)
+  std::vector<float> thermalField;     // 암시적 풀이용 float 온도 평면 (처음 쓸 때 할당)
+  std::vector<float> thermalSweep;     // 암시적 풀이의 계수/소거 계수 평면 + 행 묶음 버퍼
+  std::vector<ThermalBlock> thermalBlocks;  // 다중 해상도 풀이의 공기 블록 (다른 풀이에서는 비어 있음)
+  std::vector<ThermalBlockRow> thermalBlockRows;  // 다중 해상도 풀이의 블록 행 상태
+  std::vector<float> thermalFine;      // 다중 해상도 풀이의 블록 행 버퍼
+  int thermalMatterBlocks;             // 다중 해상도 풀이가 지난번에 셀 단위로 푼 블록 수
+  bool thermalExplicitFallback;        // 물질이 많아 다중 해상도 대신 명시적으로 푸는 중
+  std::vector<uint8_t> thermalTypeRows;  // 타일 배치에서 풀이가 행 단위로 모아 읽는 type 행
+
+  // === 비동기 열 전도 (physics/heat_conduction.h) ===
+  // 있으면 열 전도를 작업 스레드에서 한 프레임 늦게 실행 (nullptr이면 프레임 안에서 실행)
+  // 바꾸기 전에 finishHeatConductionAsync()로 진행 중인 작업을 끝내야 함
+  BackgroundWorker* thermalWorker;
+  bool thermalPending;                             // 작업 스레드에서 실행 중인 열 전도가 있음
+  std::vector<TemperatureValue> thermalSnapshot;   // 작업 시작 시점의 온도 평면 복사본
+  std::vector<TemperatureValue> thermalResult;     // 작업 결과 (끝나면 복사본 대비 변화량)
+  std::vector<uint8_t> thermalRowChanged;          // 행별 변화량이 있는지 (합칠 때 나머지 행은 건너뜀)
+  std::vector<uint8_t> thermalTypes;               // 작업 시작 시점의 type 평면 복사본
+  std::vector<ChunkRect> thermalChunkRects;        // 작업이 깨울 영역
+
+  World() : width(0), height(0), size(0), stride(0), planeSize(0), planeOrigin(0),
+            chunkWidth(0), chunkHeight(0), chunkCount(0),
+            grid(), nextGrid(), frameEpoch(1),
+            seed(DEFAULT_SEED), frame(0), rng(DEFAULT_SEED, 0), reactions(nullptr),
+            reactiveWordsPerRow(0), reactiveRegistry(nullptr), reactiveVersion(0),
+            occupancyWordsPerRow(0),
+            threadPool(nullptr), thermalChunkStep(0.0f),
+            thermalSolver(HEAT_SOLVER_EXPLICIT), thermalInterval(1),
+            thermalMatterBlocks(0), thermalExplicitFallback(false),
+            thermalWorker(nullptr), thermalPending(false) {}
+  ~World();   // 진행 중인 비동기 열 전도를 기다림
+  World(const World&) = delete;
+  World& operator=(const World&) = delete;
+};
+
+// 월드를 width x height 크기로 할당하고 초기화
+// 크기가 0 이하이면 기본 크기(DEFAULT_WIDTH x DEFAULT_HEIGHT)를 사용
+void initWorld(World& world, int width, int height);
+
+// 월드 시드 변경 (순차 스트림도 다시 시작)
+// 같은 시드로 initWorld 후 같은 입력을 주면 프레임이 비트 단위로 재현됨
+void setWorldSeed(World& world, uint64_t seed);
+
+// 이번 프레임의 (패스, 행, 청크 열) 난수 스트림
+inline Rng worldStreamRng(const World& world, RngPass pass, int y, uint32_t cx) {
+  return makeStreamRng(world.seed, world.frame, pass, y, cx);
+}
+
+// 헬퍼 함수: 그리드 인덱스 계산 (평면 포인터 기준, 고스트 셀은 음수일 수 있음)
+// -GHOST_X <= x < width + GHOST_X, -GHOST_Y <= y < height + GHOST_Y 에서 유효
+#ifdef POWDER_TILED_LAYOUT
+static_assert(GHOST_X <= CHUNK_SIZE && GHOST_Y <= CHUNK_SIZE, "ghost cells must fit in one border tile");
+
+inline int getIndex(const World& world, int x, int y) {
+  // 음수 좌표는 산술 시프트로 테두리 타일(-1)에 들어감
+  // (타일 번호는 음수일 수 있으므로 왼쪽 시프트 대신 곱셈)
+  return (y >> CHUNK_SHIFT) * world.stride + (x >> CHUNK_SHIFT) * CHUNK_CELLS +
+         ((y & (CHUNK_SIZE - 1)) << CHUNK_SHIFT) + (x & (CHUNK_SIZE - 1));
+}
+
+// 행에서 x부터 평면에 연속으로 놓인 구간의 끝 (타일 경계)
+inline int getRowRunEnd(const World&, int x) {
+  return (x | (CHUNK_SIZE - 1)) + 1;
+}
+#else
+inline int getIndex(const World& world, int x, int y) {
+  return y * world.stride + x;
+}
+
+// 행에서 x부터 평면에 연속으로 놓인 구간의 끝 (행 끝의 고스트까지)
+inline int getRowRunEnd(const World& world, int) {
+  return world.width + GHOST_X;
+}
+#endif
+
+// 행 y의 [x0, x1)을 평면에서 연속인 구간으로 나눠 fn(x, idx, count) 호출
+// (행 우선 배치에서는 한 번, 타일 배치에서는 타일마다 한 번)
+template <typename Fn>
+inline void forEachRowRun(const World& world, int y, int x0, int x1, Fn fn) {
+  while (x0 < x1) {
+    int end = getRowRunEnd(world, x0);
+    if (end > x1) end = x1;
+    fn(x0, getIndex(world, x0, y), end - x0);
+    x0 = end;
+  }
+}
+
+// 헬퍼 함수: 범위 체크 (외부 입력용, 패스 안의 이웃 검사는 고스트 셀이 대신함)
+inline bool inBounds(const World& world, int x, int y) {
+  return x >= 0 && x < world.width && y >= 0 && y < world.height;
+}
+
+#endif // WORLD_H
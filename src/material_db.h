@@ -9,6 +9,7 @@ struct Material {
   int default_state;             // 기본 물리 상태
   float density;                 // 밀도 (kg/m³)
   float specific_heat;           // 비열 (J/(kg·K))
+  float thermal_conductivity;    // 열전도율 (W/(m·K))
   float melting_point;           // 녹는점 (°C)
   float boiling_point;           // 끓는점 (°C)
   float latent_heat_fusion;      // 융해 잠열 (J/kg)
@@ -26,6 +27,7 @@ const Material g_MaterialDB[] = {
         .default_state = STATE_GAS,
         .density = 1.2f,
         .specific_heat = 1005.0f,  // 공기의 비열
+        .thermal_conductivity = 0.026f, // 공기
         .melting_point = -999.0f,  // 상태 전이 없음
         .boiling_point = -999.0f,
         .latent_heat_fusion = 0.0f,
@@ -40,6 +42,7 @@ const Material g_MaterialDB[] = {
         .default_state = STATE_SOLID,
         .density = 2500.0f,        // 콘크리트 밀도
         .specific_heat = 840.0f,   // 콘크리트 비열
+        .thermal_conductivity = 1.7f, // 콘크리트
         .melting_point = 1500.0f,  // 매우 높은 녹는점
         .boiling_point = 2800.0f,
         .latent_heat_fusion = 0.0f,
@@ -54,6 +57,7 @@ const Material g_MaterialDB[] = {
         .default_state = STATE_POWDER,
         .density = 1600.0f,        // 모래 밀도
         .specific_heat = 830.0f,   // 모래 비열
+        .thermal_conductivity = 0.25f, // 건조한 모래
         .melting_point = 1700.0f,  // 유리화 온도
         .boiling_point = 2230.0f,
         .latent_heat_fusion = 0.0f,
@@ -68,6 +72,7 @@ const Material g_MaterialDB[] = {
         .default_state = STATE_LIQUID,
         .density = 1000.0f,        // 물 밀도
         .specific_heat = 4186.0f,  // 물의 높은 비열
+        .thermal_conductivity = 0.6f,
         .melting_point = 0.0f,     // 얼음 → 물
         .boiling_point = 100.0f,   // 물 → 증기
         .latent_heat_fusion = 334000.0f,      // 융해열
@@ -82,6 +87,7 @@ const Material g_MaterialDB[] = {
         .default_state = STATE_SOLID,
         .density = 917.0f,         // 얼음 밀도 (물보다 낮음)
         .specific_heat = 2050.0f,  // 얼음 비열
+        .thermal_conductivity = 2.2f,
         .melting_point = 0.0f,     // 얼음 → 물
         .boiling_point = 100.0f,   // (물을 거쳐 증기로)
         .latent_heat_fusion = 334000.0f,
@@ -96,6 +102,7 @@ const Material g_MaterialDB[] = {
         .default_state = STATE_GAS,
         .density = 0.6f,           // 수증기 밀도 (공기보다 낮음)
         .specific_heat = 2080.0f,  // 수증기 비열
+        .thermal_conductivity = 0.025f,
         .melting_point = 0.0f,
         .boiling_point = 100.0f,   // 증기 → 물
         .latent_heat_fusion = 334000.0f,
@@ -110,6 +117,7 @@ const Material g_MaterialDB[] = {
         .default_state = STATE_GAS,
         .density = 0.3f,           // 매우 낮은 밀도 (위로 올라감)
         .specific_heat = 1000.0f,
+        .thermal_conductivity = 0.05f, // 뜨거운 기체
         .melting_point = -999.0f,  // 상태 전이 없음
         .boiling_point = -999.0f,
         .latent_heat_fusion = 0.0f,
@@ -124,6 +132,7 @@ const Material g_MaterialDB[] = {
         .default_state = STATE_GAS,
         .density = 1.4f,           // 공기보다 약간 무거움
         .specific_heat = 920.0f,
+        .thermal_conductivity = 0.026f,
         .melting_point = -218.0f,
         .boiling_point = -183.0f,
         .latent_heat_fusion = 0.0f,
@@ -138,6 +147,7 @@ const Material g_MaterialDB[] = {
         .default_state = STATE_GAS,
         .density = 0.09f,          // 매우 가벼움 (빠르게 위로)
         .specific_heat = 14300.0f, // 매우 높은 비열
+        .thermal_conductivity = 0.18f, // 기체 중 높은 편
         .melting_point = -259.0f,
         .boiling_point = -253.0f,
         .latent_heat_fusion = 0.0f,
@@ -152,6 +162,7 @@ const Material g_MaterialDB[] = {
         .default_state = STATE_GAS,
         .density = 2.5f,           // 수증기보다 무거움
         .specific_heat = 2000.0f,
+        .thermal_conductivity = 0.03f,
         .melting_point = -999.0f,
         .boiling_point = 300.0f,   // 300°C 이하로 냉각되면 기름으로
         .latent_heat_fusion = 0.0f,
@@ -166,6 +177,7 @@ const Material g_MaterialDB[] = {
         .default_state = STATE_SOLID,
         .density = 600.0f,         // 물보다 가벼움
         .specific_heat = 1700.0f,
+        .thermal_conductivity = 0.15f,
         .melting_point = -999.0f,  // 녹지 않음
         .boiling_point = -999.0f,  // 발화점은 화학반응으로 처리
         .latent_heat_fusion = 0.0f,
@@ -180,6 +192,7 @@ const Material g_MaterialDB[] = {
         .default_state = STATE_SOLID,
         .density = 7874.0f,        // 매우 무거움
         .specific_heat = 449.0f,
+        .thermal_conductivity = 80.0f, // 금속: 열을 빠르게 전달
         .melting_point = 1538.0f,  // 높은 녹는점
         .boiling_point = 2862.0f,
         .latent_heat_fusion = 247000.0f,
@@ -194,6 +207,7 @@ const Material g_MaterialDB[] = {
         .default_state = STATE_POWDER,
         .density = 534.0f,         // 가벼운 금속
         .specific_heat = 3582.0f,  // 높은 비열
+        .thermal_conductivity = 85.0f,
         .melting_point = 180.5f,
         .boiling_point = 1342.0f,
         .latent_heat_fusion = 432000.0f,
@@ -208,6 +222,7 @@ const Material g_MaterialDB[] = {
         .default_state = STATE_POWDER,
         .density = 971.0f,         // 물보다 약간 가벼움
         .specific_heat = 1230.0f,
+        .thermal_conductivity = 142.0f,
         .melting_point = 97.7f,
         .boiling_point = 883.0f,
         .latent_heat_fusion = 113000.0f,
@@ -222,6 +237,7 @@ const Material g_MaterialDB[] = {
         .default_state = STATE_LIQUID,
         .density = 900.0f,         // 물보다 가벼움 (위로 뜸)
         .specific_heat = 2000.0f,
+        .thermal_conductivity = 0.15f,
         .melting_point = -40.0f,
         .boiling_point = 300.0f,   // 300°C에서 유증기로
         .latent_heat_fusion = 0.0f,
@@ -236,6 +252,7 @@ const Material g_MaterialDB[] = {
         .default_state = STATE_GAS,
         .density = 1.98f,          // 공기보다 무거움 (아래로 가라앉음)
         .specific_heat = 840.0f,
+        .thermal_conductivity = 0.017f,
         .melting_point = -78.5f,   // 드라이아이스
         .boiling_point = -78.5f,   // 승화
         .latent_heat_fusion = 0.0f,
@@ -0,0 +1,54 @@
+#include "material_table.h"
+#include "../material_db.h"
+
+// displace 비트마스크는 타입마다 1비트
+static_assert(MATERIAL_COUNT <= 32, "displace mask is 32-bit");
+// 순위 1 ~ MATERIAL_COUNT - 1은 고체 순위보다 낮아야 함
+static_assert(MATERIAL_COUNT <= MATERIAL_RANK_SOLID, "movement ranks must fit below the solid rank");
+
+MaterialTable::MaterialTable() {
+  for (int t = 0; t < 256; t++) {
+    const Material& mat = getMaterial(t);
+    state[t] = static_cast<uint8_t>(mat.default_state);
+    density[t] = mat.density;
+    conductivity[t] = mat.thermal_conductivity;
+    color[t] = (static_cast<uint32_t>(mat.color[0]) << 16) |
+               (static_cast<uint32_t>(mat.color[1]) << 8) |
+               static_cast<uint32_t>(mat.color[2]);
+  }
+
+  // canMoveTo()의 규칙: 빈 셀 → 가능, 고체 → 불가, 나머지 → 밀도가 더 높을 때만
+  for (int mover = 0; mover < 256; mover++) {
+    uint32_t mask = 1u << EMPTY;
+    for (int target = 0; target < MATERIAL_COUNT; target++) {
+      if (target == EMPTY || state[target] == STATE_SOLID) continue;
+      if (density[mover] > density[target]) mask |= 1u << target;
+    }
+    displace[mover] = mask;
+  }
+
+  // 이동 순위: 더 가벼운 (고체가 아닌) 물질의 서로 다른 밀도 개수 + 1
+  for (int t = 0; t < 256; t++) {
+    rank[t] = MATERIAL_RANK_SOLID;
+    if (t >= MATERIAL_COUNT || state[t] == STATE_SOLID) continue;
+    if (t == EMPTY) {
+      rank[t] = 0;
+      continue;
+    }
+    int lighter = 0;
+    for (int other = 0; other < MATERIAL_COUNT; other++) {
+      if (other == EMPTY || state[other] == STATE_SOLID || density[other] >= density[t]) continue;
+      bool seen = false;
+      for (int prev = 0; prev < other; prev++) {
+        if (prev != EMPTY && state[prev] != STATE_SOLID && density[prev] == density[other]) seen = true;
+      }
+      if (!seen) lighter++;
+    }
+    rank[t] = static_cast<uint8_t>(lighter + 1);
+  }
+}
+
+const MaterialTable& getMaterialTable() {
+  static const MaterialTable table;
+  return table;
+}
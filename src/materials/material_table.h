@@ -0,0 +1,44 @@
+#ifndef MATERIAL_TABLE_H
+#define MATERIAL_TABLE_H
+
+#include <cstdint>
+
+// ============================================================================
+// 물질 속성 LUT
+// ----------------------------------------------------------------------------
+// 패스의 안쪽 루프가 Material 구조체(g_MaterialDB) 대신 type 평면 값(0~255)으로
+// 바로 조회하는 평평한 표입니다. 처음 조회할 때 한 번 만들어지므로 패스는
+// 루프 밖에서 getMaterialTable()을 받아 둡니다.
+// DB에 없는 타입은 getMaterial()과 같이 EMPTY로 취급합니다.
+// ============================================================================
+
+// 이동 순위 비트 수 (점유 비트맵의 비트 평면 수, core/occupancy.h)
+const int MATERIAL_RANK_BITS = 5;
+const int MATERIAL_RANK_SOLID = (1 << MATERIAL_RANK_BITS) - 1;
+
+struct MaterialTable {
+  uint8_t state[256];        // 기본 물리 상태
+  float density[256];        // 밀도 (kg/m³)
+  float conductivity[256];   // 열전도율 (W/(m·K))
+  uint32_t color[256];       // RGB 색상 (0xRRGGBB)
+
+  // 비트 b: 이 물질이 타입 b 셀로 이동(자리 교환)할 수 있음
+  // 빈 셀은 항상, 고체 셀은 항상 불가, 나머지는 밀도가 더 낮을 때만
+  // (state 평면은 항상 타입의 기본 상태이므로 타입 쌍만으로 정해짐)
+  uint32_t displace[256];
+
+  // 이동 순위: 빈 셀 0, 고체 MATERIAL_RANK_SOLID, 나머지는 밀도 오름차순 (같은 밀도는 같은 순위)
+  // 고체가 아닌 입자는 자기보다 순위가 낮은 셀로만 이동 가능 (displace와 같은 규칙)
+  uint8_t rank[256];
+
+  MaterialTable();
+};
+
+const MaterialTable& getMaterialTable();
+
+// mover 입자가 target 타입 셀로 이동할 수 있는지 (target < MATERIAL_COUNT)
+inline bool canDisplace(const MaterialTable& table, int mover, int target) {
+  return (table.displace[mover] >> target) & 1u;
+}
+
+#endif // MATERIAL_TABLE_H
@@ -1,71 +1,92 @@
 #include "special_materials.h"
 #include "../core/grid.h"
+#include "../core/occupancy.h"
 #include "../core/types.h"
 #include "../particle.h"
-#include <cstdlib>
 
-void updateLifeAndSpecialMaterials() {
-  for (int y = 0; y < HEIGHT; y++) {
-    for (int x = 0; x < WIDTH; x++) {
-      int idx = getIndex(x, y);
-      Particle& p = nextGrid[idx];
+void updateLifeAndSpecialMaterials(World& world) {
+  // 깨어 있는 청크의 더티 영역만 청크(타일) 단위로 처리
+  for (int chunkIdx = 0; chunkIdx < world.chunkCount; chunkIdx++) {
+    ChunkRect r;
+    if (!getActiveChunkRect(world, chunkIdx, r)) continue;
+    int cx = chunkIdx % world.chunkWidth;
+
+    for (int y = r.minY; y <= r.maxY; y++) {
+      Rng rng = worldStreamRng(world, RNG_PASS_LIFE, y, cx);
+
+      // 빈 셀은 점유 비트맵으로 건너뜀
+      // 불이 같은 행의 뒤쪽 칸으로 번질 수 있으므로 셀마다 남은 구간의 비트를 다시 읽음
+      int count = r.maxX - r.minX + 1;
+      uint64_t pending = count >= 64 ? ~0ull : (1ull << count) - 1;
+      uint64_t occupied;
+      while ((occupied = loadOccupiedBits(world, world.nextGrid, y, r.minX, count) & pending) != 0) {
+        int i = __builtin_ctzll(occupied);
+        pending &= ~((2ull << i) - 1);
+        int x = r.minX + i;
+        int idx = getIndex(world, x, y);
+        int type = world.nextGrid.type[idx];
       
-      if (p.type == EMPTY || p.type == WALL) continue;
+        if (type == EMPTY || type == WALL) continue;
       
-      // 수명 감소
-      if (p.life > 0) {
-        p.life--;
-        if (p.life == 0) {
-          // 수명 다하면 소멸
-          p.type = EMPTY;
-          p.state = STATE_GAS;
-          markChunkActive(x, y);
-          continue;
+        // 수명 감소 (수명 평면만 사용)
+        int16_t& life = world.nextGrid.life[idx];
+        if (life > 0) {
+          life--;
+          if (life == 0) {
+            // 수명 다하면 소멸
+            world.nextGrid.type[idx] = EMPTY;
+            world.nextGrid.state[idx] = STATE_GAS;
+            updateOccupancy(world, world.nextGrid, x, y);
+            markChunkActive(world, x, y);
+            continue;
+          }
+          // 수명이 남은 입자는 계속 깨어 있어야 함
+          markChunkActive(world, x, y);
         }
-      }
       
-      // FIRE: 주변을 가열하고 위로 올라가며 소멸
-      if (p.type == FIRE) {
-        // 주변을 가열 (임시 비활성화)
-        // for (int dy = -1; dy <= 1; dy++) {
-        //   for (int dx = -1; dx <= 1; dx++) {
-        //     if (dx == 0 && dy == 0) continue;
-        //     int nx = x + dx;
-        //     int ny = y + dy;
-        //     if (inBounds(nx, ny)) {
-        //       int nIdx = getIndex(nx, ny);
-        //       // 온도 증가 (최대 800도까지)
-        //       nextGrid[nIdx].temperature += 80.0f;
-        //       if (nextGrid[nIdx].temperature > 800.0f) {
-        //         nextGrid[nIdx].temperature = 800.0f;
-        //       }
-        //       markChunkActive(nx, ny);
-        //     }
-        //   }
-        // }
+        // FIRE: 주변을 가열하고 위로 올라가며 소멸
+        if (type == FIRE) {
+          // 주변을 가열 (임시 비활성화)
+          // for (int dy = -1; dy <= 1; dy++) {
+          //   for (int dx = -1; dx <= 1; dx++) {
+          //     if (dx == 0 && dy == 0) continue;
+          //     int nx = x + dx;
+          //     int ny = y + dy;
+          //     if (inBounds(nx, ny)) {
+          //       int nIdx = getIndex(nx, ny);
+          //       // 온도 증가 (최대 800도까지)
+          //       nextGrid.temperature[nIdx] += 80.0f;
+          //       if (nextGrid.temperature[nIdx] > 800.0f) {
+          //         nextGrid.temperature[nIdx] = 800.0f;
+          //       }
+          //       markChunkActive(nx, ny);
+          //     }
+          //   }
+          // }
         
-        // 랜덤하게 확산 (부모보다 life 감소)
-        if (rand() % 3 == 0 && p.life > 10) { // life가 10 이상일 때만 확산
-          int dir = rand() % 4;
-          int nx = x + (dir == 0 ? -1 : dir == 1 ? 1 : 0);
-          int ny = y + (dir == 2 ? -1 : dir == 3 ? 1 : 0);
+          // 랜덤하게 확산 (부모보다 life 감소)
+          if (rng.nextInt(3) == 0 && life > 10) { // life가 10 이상일 때만 확산
+            int dir = rng.nextInt(4);
+            int nx = x + (dir == 0 ? -1 : dir == 1 ? 1 : 0);
+            int ny = y + (dir == 2 ? -1 : dir == 3 ? 1 : 0);
           
-          if (inBounds(nx, ny)) {
-            int nIdx = getIndex(nx, ny);
-            if (nextGrid[nIdx].type == EMPTY && nextGrid[nIdx].temperature > 80.0f) {
+            // 월드 밖은 고스트 WALL이므로 EMPTY 검사에서 걸러짐
+            int nIdx = getIndex(world, nx, ny);
+            if (world.nextGrid.type[nIdx] == EMPTY && getTemperature(world.nextGrid, nIdx) > 80.0f) {
               // 뜨거운 곳에 불 확산 (부모보다 life 5-10 감소)
-              int newLife = p.life - 5 - rand() % 6;
+              int newLife = life - 5 - rng.nextInt(6);
               if (newLife > 0) {
-                nextGrid[nIdx].type = FIRE;
-                nextGrid[nIdx].state = STATE_GAS;
-                nextGrid[nIdx].life = newLife;
-                markChunkActive(nx, ny);
+                world.nextGrid.type[nIdx] = FIRE;
+                world.nextGrid.state[nIdx] = STATE_GAS;
+                world.nextGrid.life[nIdx] = newLife;
+                updateOccupancy(world, world.nextGrid, nx, ny);
+                markChunkActive(world, nx, ny);
               }
             }
           }
         }
-      }
       
+      }
     }
   }
 }
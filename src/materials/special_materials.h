@@ -1,8 +1,10 @@
 #ifndef SPECIAL_MATERIALS_H
 #define SPECIAL_MATERIALS_H
 
+#include "../core/world.h"
+
 // PASS 4.5: 수명 감소 및 특수 물질 처리
 // FIRE의 수명 감소, 확산, 열 전달 등을 처리합니다.
-void updateLifeAndSpecialMaterials();
+void updateLifeAndSpecialMaterials(World& world);
 
 #endif // SPECIAL_MATERIALS_H
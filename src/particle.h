@@ -37,7 +37,9 @@ enum PhysicalState {
   STATE_GAS = 3      // 기체 (위로 올라감)
 };
 
-// 입자 구조체 (셀 상태)
+// 입자 구조체 (셀 1개의 값)
+// 그리드는 필드별 평면(core/cell_planes.h)에 저장되며, 이 구조체는
+// loadParticle()/storeParticle()로 셀 1개를 주고받을 때 사용합니다.
 struct Particle {
   // === 1. 물질 그리드 ===
   int type;          // 물질 ID (0=EMPTY, 1=WALL, 2=SAND...)
@@ -49,11 +51,9 @@ struct Particle {
   // === 3. 물리 상태 (물질이 있을 경우) ===
   int state;         // 물리 상태 (SOLID, POWDER, LIQUID, GAS)
   float vx, vy;      // 속도 (픽셀/프레임)
-  float latent_heat_storage; // 축적된 잠열 (상태 전이용)
 
   // === 4. 기타 상태 ===
   int life;          // 수명 (-1 = 무한, 0 = 소멸)
-  bool updated_this_frame; // 이동 최적화용 플래그
 
   // 생성자
   Particle() 
@@ -62,9 +62,7 @@ struct Particle {
       state(STATE_SOLID),
       vx(0.0f), 
       vy(0.0f), 
-      latent_heat_storage(0.0f),
-      life(-1), 
-      updated_this_frame(false) {}
+      life(-1) {}
 };
 
 #endif // PARTICLE_H
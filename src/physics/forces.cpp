@@ -1,65 +1,80 @@
 #include "forces.h"
 #include "../core/grid.h"
+#include "../core/occupancy.h"
 #include "../core/types.h"
-#include "../material_db.h"
+#include "../materials/material_table.h"
 #include <cmath>
-#include <cstdlib>
 
-void updateForces() {
-  for (int y = 0; y < HEIGHT; y++) {
-    for (int x = 0; x < WIDTH; x++) {
-      int idx = getIndex(x, y);
-      Particle& p = nextGrid[idx];
+void updateForces(World& world) {
+  const MaterialTable& table = getMaterialTable();
+
+  // 깨어 있는 청크의 더티 영역만 청크(타일) 단위로 처리
+  // (셀마다 자기 속도만 바꾸므로 처리 순서와 무관)
+  for (int chunkIdx = 0; chunkIdx < world.chunkCount; chunkIdx++) {
+    ChunkRect r;
+    if (!getActiveChunkRect(world, chunkIdx, r)) continue;
+    int cx = chunkIdx % world.chunkWidth;
+
+    for (int y = r.minY; y <= r.maxY; y++) {
+      Rng rng = worldStreamRng(world, RNG_PASS_FORCES, y, cx);
+
+      // 빈 셀은 점유 비트맵으로 건너뜀 (이 패스는 type을 바꾸지 않음)
+      uint64_t occupied = loadOccupiedBits(world, world.nextGrid, y, r.minX, r.maxX - r.minX + 1);
+      while (occupied != 0) {
+        int x = r.minX + __builtin_ctzll(occupied);
+        occupied &= occupied - 1;
+        int idx = getIndex(world, x, y);
+        int type = world.nextGrid.type[idx];
+        int state = world.nextGrid.state[idx];
       
-      if (p.type == EMPTY || p.type == WALL) continue;
-      if (p.state == STATE_SOLID) continue;
+        if (type == EMPTY || type == WALL) continue;
+        if (state == STATE_SOLID) continue;
       
-      const Material& mat = getMaterial(p.type);
+        float density = table.density[type];
+        float vx = getVx(world.nextGrid, idx);
+        float vy = getVy(world.nextGrid, idx);
       
-      // 중력 적용 (밀도에 비례)
-      // 밀도가 공기(1.2)보다 높으면 아래로, 낮으면 위로
-      float densityRatio = (mat.density - 1.2f) / 1000.0f;
-      p.vy += GRAVITY * densityRatio;
+        // 중력 적용 (밀도에 비례)
+        // 밀도가 공기(1.2)보다 높으면 아래로, 낮으면 위로
+        float densityRatio = (density - 1.2f) / 1000.0f;
+        vy += GRAVITY * densityRatio;
       
-      // 액체 수평 가속 (퍼짐 효과 강화)
-      if (p.state == STATE_LIQUID) {
-        // 아래가 막혔는지 확인 (바닥이거나, 비어있지 않고 나보다 밀도가 높거나 같은 물질)
-        bool blockedDown = (y >= HEIGHT - 1);
-        if (!blockedDown) {
-            int downIdx = getIndex(x, y + 1);
-            const Particle& downP = grid[downIdx]; // 현재 상태(grid) 확인
-            if (downP.type != EMPTY) {
-                 const Material& downMat = getMaterial(downP.type);
-                 if (downMat.density >= mat.density) {
-                     blockedDown = true;
-                 }
-            }
-        }
+        // 액체 수평 가속 (퍼짐 효과 강화)
+        if (state == STATE_LIQUID) {
+          // 아래가 막혔는지 확인 (벽(바닥 고스트 포함)이거나, 비어있지 않고 나보다 밀도가 높거나 같은 물질)
+          int downType = world.grid.type[getIndex(world, x, y + 1)]; // 현재 상태(grid) 확인
+          bool blockedDown = downType == WALL ||
+                             (downType != EMPTY && table.density[downType] >= density);
 
-        if (blockedDown) {
-            float flowForce = 0.5f; // 흐름 가속도 (값을 키워 반응성 향상)
+          if (blockedDown) {
+              float flowForce = 0.5f; // 흐름 가속도 (값을 키워 반응성 향상)
             
-            bool clearLeft = (x > 0 && grid[getIndex(x - 1, y)].type == EMPTY);
-            bool clearRight = (x < WIDTH - 1 && grid[getIndex(x + 1, y)].type == EMPTY);
+              // 월드 밖은 고스트 WALL이므로 비어 있지 않음
+              bool clearLeft = world.grid.type[getIndex(world, x - 1, y)] == EMPTY;
+              bool clearRight = world.grid.type[getIndex(world, x + 1, y)] == EMPTY;
             
-            if (clearLeft && !clearRight) {
-                p.vx -= flowForce;
-            } else if (!clearLeft && clearRight) {
-                p.vx += flowForce;
-            } else if (clearLeft && clearRight) {
-                // 양쪽 다 비었으면 기존 속도 방향 유지하거나 랜덤
-                if (std::abs(p.vx) < 0.1f) {
-                    p.vx += (rand() % 2 == 0 ? flowForce : -flowForce);
-                }
-            }
+              if (clearLeft && !clearRight) {
+                  vx -= flowForce;
+              } else if (!clearLeft && clearRight) {
+                  vx += flowForce;
+              } else if (clearLeft && clearRight) {
+                  // 양쪽 다 비었으면 기존 속도 방향 유지하거나 랜덤
+                  if (std::abs(vx) < 0.1f) {
+                      vx += rng.nextSign() * flowForce;
+                  }
+              }
+          }
         }
-      }
       
-      // 속도 제한
-      if (p.vy > MAX_VELOCITY_Y) p.vy = MAX_VELOCITY_Y;
-      if (p.vy < -MAX_VELOCITY_Y) p.vy = -MAX_VELOCITY_Y;
-      if (p.vx > MAX_VELOCITY_X) p.vx = MAX_VELOCITY_X;
-      if (p.vx < -MAX_VELOCITY_X) p.vx = -MAX_VELOCITY_X;
+        // 속도 제한
+        if (vy > MAX_VELOCITY_Y) vy = MAX_VELOCITY_Y;
+        if (vy < -MAX_VELOCITY_Y) vy = -MAX_VELOCITY_Y;
+        if (vx > MAX_VELOCITY_X) vx = MAX_VELOCITY_X;
+        if (vx < -MAX_VELOCITY_X) vx = -MAX_VELOCITY_X;
+      
+        setVx(world.nextGrid, idx, vx);
+        setVy(world.nextGrid, idx, vy);
+      }
     }
   }
 }
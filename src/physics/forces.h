@@ -1,8 +1,10 @@
 #ifndef FORCES_H
 #define FORCES_H
 
+#include "../core/world.h"
+
 // PASS 4: 힘 계산 (Forces)
 // 중력과 부력을 계산하여 입자의 속도를 업데이트합니다.
-void updateForces();
+void updateForces(World& world);
 
 #endif // FORCES_H
@@ -1,46 +1,1144 @@
 #include "heat_conduction.h"
-#include "../core/grid.h"
+#include "../core/background_worker.h"
+#include "../core/chunk_manager.h"
+#include "../core/occupancy.h"
+#include "../core/simd.h"
 #include "../core/types.h"
 #include "../material_db.h"
-#include <cmath>
-
-void updateHeatConduction() {
-  for (int y = 0; y < HEIGHT; y++) {
-    for (int x = 0; x < WIDTH; x++) {
-      int idx = getIndex(x, y);
-      const Particle& p = grid[idx];
-      const Material& mat = getMaterial(p.type);
-      
-      // 주변 4칸의 온도 수집
-      float neighborTemps[4];
-      int count = 0;
-      
-      if (inBounds(x, y - 1)) neighborTemps[count++] = grid[getIndex(x, y - 1)].temperature;
-      if (inBounds(x, y + 1)) neighborTemps[count++] = grid[getIndex(x, y + 1)].temperature;
-      if (inBounds(x - 1, y)) neighborTemps[count++] = grid[getIndex(x - 1, y)].temperature;
-      if (inBounds(x + 1, y)) neighborTemps[count++] = grid[getIndex(x + 1, y)].temperature;
-      
-      if (count == 0) continue;
-      
-      // 평균 온도 계산
-      float avgTemp = 0.0f;
-      for (int i = 0; i < count; i++) {
-        avgTemp += neighborTemps[i];
-      }
-      avgTemp /= count;
-      
-      // 비열을 고려한 열 전도율 계산
-      // 비열이 높을수록 온도 변화가 느림
-      float conductionRate = HEAT_CONDUCTION_BASE / (mat.specific_heat / 1000.0f);
-      
-      // 새 온도 계산
-      float newTemp = p.temperature + (avgTemp - p.temperature) * conductionRate;
-      nextGrid[idx].temperature = newTemp;
-      
-      // 온도가 변하면 청크 활성화
-      if (fabs(newTemp - p.temperature) > HEAT_CHANGE_THRESHOLD) {
-        markChunkActive(x, y);
+#include <cstring>
+
+// 물질별 1프레임 전도율 LUT (type 평면 값 0~255로 바로 조회)
+// 비열이 높을수록 온도 변화가 느리고, 열전도율이 기준을 넘는 물질(금속)은
+// 그 비율만큼 빠름. DB에 없는 타입은 EMPTY와 같게 취급
+// 명시적 풀이는 HEAT_EXPLICIT_MAX_RATE로 잘라 쓰고, 암시적 풀이는 그대로 사용
+struct ConductivityTable {
+  float rate[256];
+  float plainRate[256];   // 열전도율 가속을 뺀 값 (공기와 맞닿은 면)
+  float capacity[256];    // 비열 (J/(kg·K))
+
+  ConductivityTable() {
+    for (int t = 0; t < 256; t++) {
+      const Material& mat = getMaterial(t);
+      float boost = mat.thermal_conductivity / HEAT_CONDUCTIVITY_REFERENCE;
+      plainRate[t] = HEAT_CONDUCTION_BASE / (mat.specific_heat / 1000.0f);
+      rate[t] = plainRate[t] * (boost > 1.0f ? boost : 1.0f);
+      capacity[t] = mat.specific_heat;
+    }
+  }
+};
+
+static const ConductivityTable& getConductivity() {
+  static const ConductivityTable table;
+  return table;
+}
+
+// 열 전도 1회분의 입출력
+// src와 dst가 같으면 제자리 갱신 (행 버퍼가 덮어쓰기 전 값을 보관)
+struct HeatPlanes {
+  const TemperatureValue* src;   // 입력 온도 평면
+  TemperatureValue* dst;         // 결과 온도 평면
+  const uint8_t* type;           // 전도율을 정할 type 평면
+  ChunkRect* marks;              // 온도가 크게 변한 영역을 기록할 테이블
+};
+
+// 온도 count개를 float로 디코딩
+static void decodeRow(const TemperatureValue* src, float* dst, int count) {
+  int x = 0;
+#ifndef POWDER_TEMPERATURE_FP32
+  const SimdF32 invScale = simdSplat(1.0f / TEMPERATURE_SCALE);
+  for (; x + SIMD_F32_LANES <= count; x += SIMD_F32_LANES) {
+    simdStore(dst + x, simdMul(simdLoadI16(src + x), invScale));
+  }
+#endif
+  for (; x < count; x++) {
+    dst[x] = decodeTemperature(src[x]);
+  }
+}
+
+// 온도 평면의 행 y, [x0, x1)을 float로 디코딩해 dst[x0..x1)에 기록 (dst는 x로 색인)
+static void decodePlaneRow(const World& world, const TemperatureValue* plane, int y, int x0, int x1, float* dst) {
+  forEachRowRun(world, y, x0, x1, [&](int x, int idx, int count) {
+    decodeRow(&plane[idx], dst + x, count);
+  });
+}
+
+// type 평면의 행 y를 x로 바로 읽는 포인터 ([x0, x1)에서 유효)
+// 행 우선 배치는 평면을 그대로 가리키고, 타일 배치는 buffer(x로 색인)에 모아 둠
+static const uint8_t* loadTypeRow(const World& world, const uint8_t* plane, int y, int x0, int x1, uint8_t* buffer) {
+#ifdef POWDER_TILED_LAYOUT
+  forEachRowRun(world, y, x0, x1, [&](int x, int idx, int count) {
+    memcpy(buffer + x, &plane[idx], count);
+  });
+  return buffer;
+#else
+  (void)x0;
+  (void)x1;
+  (void)buffer;
+  return &plane[getIndex(world, 0, y)];
+#endif
+}
+
+// 행 y의 원래 온도를 디코딩해 좌우 고스트 셀이 있는 행 버퍼에 기록
+// 고스트 셀은 가장자리 셀 값을 복사하므로 경계로는 열이 빠져나가지 않음 (단열)
+static void loadGhostRow(const World& world, const TemperatureValue* plane, int y, float* row) {
+  int w = world.width;
+  decodePlaneRow(world, plane, y, 0, w, row + 1);
+  row[0] = row[1];
+  row[w + 1] = row[w];
+}
+
+// 계산한 온도 레인을 온도 평면 형식으로 기록
+static inline void storeTemperatureLanes(TemperatureValue* dst, SimdF32 v) {
+#ifdef POWDER_TEMPERATURE_FP32
+  simdStore(dst, v);
+#else
+  simdStoreI16(dst, simdMul(v, simdSplat(TEMPERATURE_SCALE)));
+#endif
+}
+
+// ============================================================================
+// 명시적 풀이: 주변 4칸 평균 쪽으로 전도율만큼 이동
+// ----------------------------------------------------------------------------
+// 월드 크기와 작업 버퍼만 world에서 읽고, 평면은 planes로 받음
+// (비동기 모드에서는 작업 스레드가 복사본에 대해 실행)
+// dt프레임 분량을 한 번에 진행하며, 전도율 x dt는 상한에서 잘림
+//
+// 제자리 갱신(동기 모드)이고 지난 풀이와 dt가 같으면, 자신과 주변 8청크가 모두
+// 지난 풀이 이후 바뀌지 않은 청크는 건너뜁니다. 지난 풀이에서 값이 그대로였고
+// 입력(주변 1칸을 포함한 온도, type)도 같으므로 결과도 같기 때문입니다.
+// 다른 패스가 바꾼 청크는 청크 더티 영역으로 표시하고 (trackThermalChunks),
+// 풀이가 값을 바꾼 청크는 변화가 깨우기 문턱값보다 작아도 표시합니다.
+// 빈 공간이나 온도가 고르게 가라앉은 영역은 풀지 않습니다.
+// ============================================================================
+static void conductHeatExplicit(World& world, const HeatPlanes& planes, float dt) {
+  const float* base = getConductivity().rate;
+  float lut[256];
+  for (int t = 0; t < 256; t++) {
+    float r = base[t] * dt;
+    lut[t] = r < HEAT_EXPLICIT_MAX_RATE ? r : HEAT_EXPLICIT_MAX_RATE;
+  }
+
+  int w = world.width;
+  int h = world.height;
+  int cw = world.chunkWidth;
+  int ch = world.chunkHeight;
+  float* rate = world.thermalRate.data();
+  uint8_t* typeBuffer = world.thermalTypeRows.data();
+  const SimdF32 quarter = simdSplat(0.25f);
+  const SimdF32 threshold = simdSplat(HEAT_CHANGE_THRESHOLD);
+
+  // 이번에 풀 청크를 정하고, 바뀐 청크 표시는 이번 풀이 결과로 새로 기록
+  bool inPlace = planes.dst == planes.src;
+  bool incremental = inPlace && world.thermalChunkStep == dt;
+  uint8_t* dirty = world.thermalChunkDirty.data();
+  uint8_t* solve = world.thermalChunkSolve.data();
+  for (int cy = 0; cy < ch; cy++) {
+    for (int cx = 0; cx < cw; cx++) {
+      bool needed = !incremental;
+      for (int ny = cy - 1; ny <= cy + 1 && !needed; ny++) {
+        if (ny < 0 || ny >= ch) continue;
+        for (int nx = cx - 1; nx <= cx + 1; nx++) {
+          if (nx >= 0 && nx < cw && dirty[ny * cw + nx]) {
+            needed = true;
+            break;
+          }
+        }
+      }
+      solve[cy * cw + cx] = needed;
+    }
+  }
+  if (inPlace) {
+    memset(dirty, 0, world.chunkCount);
+  }
+
+  // 온도 평면을 제자리에서 갱신할 수 있도록, 덮어쓰기 전의 윗행/현재 행/아랫행을
+  // float로 디코딩해 고스트 행 버퍼 3개에 돌려 가며 보관
+  // (위/아래 경계는 가장자리 행을 고스트로 사용)
+  float* prevRow = world.thermalScratch.data();
+  float* curRow = prevRow + (w + 2);
+  float* nextRow = curRow + (w + 2);
+  bool primed = false;   // 행 버퍼가 다음 행을 가리키는지 (건너뛴 청크 행 뒤에는 다시 채움)
+
+  for (int cy = 0; cy < ch; cy++) {
+    const uint8_t* solveRow = &solve[cy * cw];
+    bool any = false;
+    for (int cx = 0; cx < cw; cx++) any |= solveRow[cx] != 0;
+    int y0 = cy * CHUNK_SIZE;
+    int y1 = y0 + CHUNK_SIZE < h ? y0 + CHUNK_SIZE : h;
+    if (!any) {
+      primed = false;
+      continue;
+    }
+    if (!primed) {
+      loadGhostRow(world, planes.src, y0, curRow);
+      if (y0 > 0) {
+        loadGhostRow(world, planes.src, y0 - 1, prevRow);
+      } else {
+        memcpy(prevRow, curRow, (w + 2) * sizeof(float));
+      }
+      if (y0 + 1 < h) {
+        loadGhostRow(world, planes.src, y0 + 1, nextRow);
+      } else {
+        memcpy(nextRow, curRow, (w + 2) * sizeof(float));
+      }
+      primed = true;
+    }
+
+    for (int y = y0; y < y1; y++) {
+      const float* mid = curRow + 1;
+      const float* up = prevRow + 1;
+      const float* down = nextRow + 1;
+
+      // 청크 폭 단위로 처리하며, 온도가 크게 변한 셀의 범위만 깨움
+      // (청크 폭 구간은 어느 배치에서든 평면에서 연속)
+      for (int cx = 0; cx < cw; cx++) {
+        if (!solveRow[cx]) continue;
+        int sx = cx * CHUNK_SIZE;
+        int end = sx + CHUNK_SIZE < w ? sx + CHUNK_SIZE : w;
+        int changed = 0;   // 비트 i = 셀 sx + i
+        int x = sx;
+        TemperatureValue* out = &planes.dst[getIndex(world, sx, y)] - sx;   // x로 색인 (이 구간만 유효)
+        TemperatureValue before[CHUNK_SIZE];
+        if (inPlace) {
+          memcpy(before, out + sx, (end - sx) * sizeof(TemperatureValue));
+        }
+
+        // 구간의 전도율 (화학 반응 후의 타입 기준)
+        const uint8_t* type = loadTypeRow(world, planes.type, y, sx, end, typeBuffer);
+        for (int i = sx; i < end; i++) {
+          rate[i] = lut[type[i]];
+        }
+
+        // 주변 4칸 평균과의 차이만큼 전도율에 비례해 이동
+        for (; x + SIMD_F32_LANES <= end; x += SIMD_F32_LANES) {
+          SimdF32 center = simdLoad(mid + x);
+          SimdF32 sum = simdAdd(simdAdd(simdLoad(up + x), simdLoad(down + x)),
+                                simdAdd(simdLoad(mid + x - 1), simdLoad(mid + x + 1)));
+          SimdF32 delta = simdMul(simdSub(simdMul(sum, quarter), center), simdLoad(rate + x));
+          storeTemperatureLanes(out + x, simdAdd(center, delta));
+          changed |= simdMaskGreater(simdAbs(delta), threshold) << (x - sx);
+        }
+        for (; x < end; x++) {
+          float center = mid[x];
+          float delta = ((up[x] + down[x] + mid[x - 1] + mid[x + 1]) * 0.25f - center) * rate[x];
+          out[x] = encodeTemperature(center + delta);
+          if (delta > HEAT_CHANGE_THRESHOLD || delta < -HEAT_CHANGE_THRESHOLD) {
+            changed |= 1 << (x - sx);
+          }
+        }
+
+        if (inPlace && memcmp(before, out + sx, (end - sx) * sizeof(TemperatureValue)) != 0) {
+          dirty[cy * cw + cx] = 1;
+        }
+        if (changed) {
+          int first = sx + __builtin_ctz(changed);
+          int last = sx + 31 - __builtin_clz(changed);
+          markRegionActive(world, planes.marks, first - 1, y - 1, last + 1, y + 1);
+        }
+      }
+
+      // 버퍼를 한 행씩 밀어 올리고 새 아랫행을 디코딩 (마지막 행은 자기 자신이 고스트)
+      float* recycled = prevRow;
+      prevRow = curRow;
+      curRow = nextRow;
+      nextRow = recycled;
+      if (y + 2 < h) {
+        loadGhostRow(world, planes.src, y + 2, nextRow);
+      } else {
+        memcpy(nextRow, curRow, (w + 2) * sizeof(float));
+      }
+    }
+  }
+
+  // 복사본을 푼 경우(비동기)에는 평면의 청크 표시를 이어 갈 수 없으므로 다음 풀이는 전체를 풂
+  world.thermalChunkStep = inPlace ? dt : 0.0f;
+}
+
+// 지난 명시적 풀이 이후 다른 패스가 바꾼 청크를 표시 (메인 스레드, 매 프레임)
+// trackThermalBlocks()와 같은 영역을 덮으며, 풀지 않는 프레임에도 쌓아 둠
+static void trackThermalChunks(World& world) {
+  uint8_t* dirty = world.thermalChunkDirty.data();
+  for (int i = 0; i < world.chunkCount; i++) {
+    if (!isEmptyRect(unionRect(world.chunkRects[i], world.nextChunkRects[i]))) dirty[i] = 1;
+  }
+}
+
+// ============================================================================
+// 암시적 풀이 (ADI: 행 방향, 열 방향을 번갈아 암시적으로)
+// ----------------------------------------------------------------------------
+// 명시적 풀이와 같은 전도 모델 dT/dt = c (Lx + Ly) (c = 전도율 / 4,
+// Lx/Ly는 좌우/위아래 2차 차분)을 방향별로 나누어
+//   (I - dt c Lx) T* = T,  (I - dt c Ly) T' = T*
+// 를 삼중 대각 행렬 풀이(Thomas)로 구합니다. 각 단계가 대각 우세 M-행렬이라
+// 시간 간격이 커도 진동이나 과도한 값(주변보다 뜨거워지는 셀) 없이 안정적이므로,
+// 금속처럼 전도율이 큰 물질도 상한 없이 풀고 여러 프레임을 한 번에 진행할 수 있습니다.
+// 경계는 단열 (가장자리 셀은 바깥쪽 차분 항이 없음)
+// ============================================================================
+// 행 방향 풀이에서 함께 진행하는 행 수 (SIMD 레인 수의 배수)
+const int IMPLICIT_ROWS = 8;
+static_assert(IMPLICIT_ROWS % SIMD_F32_LANES == 0, "implicit row block must fill SIMD lanes");
+
+static void conductHeatImplicit(World& world, const HeatPlanes& planes, float dt) {
+  const float* base = getConductivity().rate;
+  float lut[256];   // 방향별 계수 dt x c
+  for (int t = 0; t < 256; t++) {
+    lut[t] = base[t] * dt * 0.25f;
+  }
+
+  int w = world.width;
+  int h = world.height;
+  // 행 묶음 버퍼 길이가 폭에 따라 달라지므로 셀 수가 같아도 두 길이를 모두 비교
+  size_t size = static_cast<size_t>(world.size);
+  size_t sweepSize = size + 3 * IMPLICIT_ROWS * static_cast<size_t>(w);
+  if (world.thermalField.size() != size || world.thermalSweep.size() != sweepSize) {
+    world.thermalField.resize(size);
+    world.thermalSweep.resize(sweepSize);
+  }
+  float* field = world.thermalField.data();
+  float* sweep = world.thermalSweep.data();
+
+  // 셀 평면에서 작업 평면(행 간격 w)으로 옮김
+  // 셀별 계수 평면 (열 방향 소거에서 같은 자리를 소거 계수로 덮어씀)
+  uint8_t* typeBuffer = world.thermalTypeRows.data();
+  for (int y = 0; y < h; y++) {
+    decodePlaneRow(world, planes.src, y, 0, w, &field[y * w]);
+    const uint8_t* type = loadTypeRow(world, planes.type, y, 0, w, typeBuffer);
+    float* coeff = &sweep[y * w];
+    for (int x = 0; x < w; x++) {
+      coeff[x] = lut[type[x]];
+    }
+  }
+
+  // 행 방향: 왼쪽 → 오른쪽 소거 후 역대입
+  // 소거는 셀마다 앞 셀에 의존하므로, 행 IMPLICIT_ROWS개를 [x][행] 순서의
+  // 묶음 버퍼로 옮겨 같은 x의 여러 행을 한 번에 (벡터화되는 연속 루프로) 진행
+  if (w > 1) {
+    float* values = sweep + size;             // 묶음 버퍼: 온도
+    float* coeffs = values + IMPLICIT_ROWS * w;   // 계수 dt x c
+    float* elim = coeffs + IMPLICIT_ROWS * w;     // 소거 계수
+    for (int y0 = 0; y0 < h; y0 += IMPLICIT_ROWS) {
+      int rows = h - y0 < IMPLICIT_ROWS ? h - y0 : IMPLICIT_ROWS;
+      // 남는 자리는 첫 행을 복사한 뒤 계수를 0으로 (결과는 버림)
+      const float* srcRows[IMPLICIT_ROWS];
+      const float* coeffRows[IMPLICIT_ROWS];
+      for (int r = 0; r < IMPLICIT_ROWS; r++) {
+        int y = y0 + (r < rows ? r : 0);
+        srcRows[r] = &field[y * w];
+        coeffRows[r] = &sweep[y * w];
+      }
+      for (int x = 0; x < w; x++) {
+        float* v = &values[x * IMPLICIT_ROWS];
+        float* c = &coeffs[x * IMPLICIT_ROWS];
+        for (int r = 0; r < IMPLICIT_ROWS; r++) {
+          v[r] = srcRows[r][x];
+          c[r] = coeffRows[r][x];
+        }
+      }
+      if (rows < IMPLICIT_ROWS) {
+        for (int x = 0; x < w; x++) {
+          for (int r = rows; r < IMPLICIT_ROWS; r++) coeffs[x * IMPLICIT_ROWS + r] = 0.0f;
+        }
+      }
+
+      const SimdF32 one = simdSplat(1.0f);
+      const SimdF32 zero = simdSplat(0.0f);
+      for (int r = 0; r < IMPLICIT_ROWS; r += SIMD_F32_LANES) {
+        SimdF32 c = simdLoad(coeffs + r);
+        SimdF32 inv = simdDiv(one, simdAdd(one, c));
+        simdStore(elim + r, simdMul(simdSub(zero, c), inv));
+        simdStore(values + r, simdMul(simdLoad(values + r), inv));
+      }
+      for (int x = 1; x < w; x++) {
+        // 오른쪽 끝은 바깥 차분 항 없음
+        const SimdF32 edge = simdSplat(x + 1 < w ? 2.0f : 1.0f);
+        float* v = &values[x * IMPLICIT_ROWS];
+        float* e = &elim[x * IMPLICIT_ROWS];
+        const float* cs = &coeffs[x * IMPLICIT_ROWS];
+        for (int r = 0; r < IMPLICIT_ROWS; r += SIMD_F32_LANES) {
+          SimdF32 c = simdLoad(cs + r);
+          SimdF32 diag = simdAdd(simdAdd(one, simdMul(edge, c)), simdMul(c, simdLoad(e + r - IMPLICIT_ROWS)));
+          SimdF32 inv = simdDiv(one, diag);
+          simdStore(e + r, simdMul(simdSub(zero, c), inv));
+          simdStore(v + r, simdMul(simdAdd(simdLoad(v + r), simdMul(c, simdLoad(v + r - IMPLICIT_ROWS))), inv));
+        }
+      }
+      for (int x = w - 2; x >= 0; x--) {
+        float* v = &values[x * IMPLICIT_ROWS];
+        const float* e = &elim[x * IMPLICIT_ROWS];
+        for (int r = 0; r < IMPLICIT_ROWS; r += SIMD_F32_LANES) {
+          simdStore(v + r, simdSub(simdLoad(v + r), simdMul(simdLoad(e + r), simdLoad(v + r + IMPLICIT_ROWS))));
+        }
+      }
+
+      for (int r = 0; r < rows; r++) {
+        float* t = &field[(y0 + r) * w];
+        for (int x = 0; x < w; x++) {
+          t[x] = values[x * IMPLICIT_ROWS + r];
+        }
+      }
+    }
+  }
+
+  // 열 방향: 모든 열을 한 행씩 함께 소거 (안쪽 루프가 연속 메모리라 벡터화됨)
+  if (h > 1) {
+    for (int x = 0; x < w; x++) {
+      float c = sweep[x];
+      float inv = 1.0f / (1.0f + c);
+      sweep[x] = -c * inv;
+      field[x] *= inv;
+    }
+    for (int y = 1; y < h; y++) {
+      const float* upSweep = &sweep[(y - 1) * w];
+      const float* up = &field[(y - 1) * w];
+      float* rowSweepY = &sweep[y * w];
+      float* t = &field[y * w];
+      bool last = y + 1 == h;
+      for (int x = 0; x < w; x++) {
+        float c = rowSweepY[x];
+        float inv = 1.0f / ((last ? 1.0f + c : 1.0f + 2.0f * c) + c * upSweep[x]);
+        rowSweepY[x] = last ? 0.0f : -c * inv;
+        t[x] = (t[x] + c * up[x]) * inv;
+      }
+    }
+    for (int y = h - 2; y >= 0; y--) {
+      const float* rowSweepY = &sweep[y * w];
+      const float* down = &field[(y + 1) * w];
+      float* t = &field[y * w];
+      for (int x = 0; x < w; x++) {
+        t[x] -= rowSweepY[x] * down[x];
+      }
+    }
+  }
+
+  // 결과를 온도 평면에 기록하며 크게 변한 셀의 범위를 청크 폭 단위로 깨움
+  // (src와 dst가 같아도 같은 셀을 읽은 뒤 쓰므로 안전)
+  const SimdF32 threshold = simdSplat(HEAT_CHANGE_THRESHOLD);
+  float* before = world.thermalRate.data();
+  for (int y = 0; y < h; y++) {
+    decodePlaneRow(world, planes.src, y, 0, w, before);
+    const float* t = &field[y * w];
+    for (int sx = 0; sx < w; sx += CHUNK_SIZE) {
+      int end = sx + CHUNK_SIZE < w ? sx + CHUNK_SIZE : w;
+      int changed = 0;   // 비트 i = 셀 sx + i
+      int x = sx;
+      TemperatureValue* out = &planes.dst[getIndex(world, sx, y)] - sx;   // x로 색인 (이 구간만 유효)
+      for (; x + SIMD_F32_LANES <= end; x += SIMD_F32_LANES) {
+        SimdF32 value = simdLoad(t + x);
+        storeTemperatureLanes(out + x, value);
+        changed |= simdMaskGreater(simdAbs(simdSub(value, simdLoad(before + x))), threshold) << (x - sx);
+      }
+      for (; x < end; x++) {
+        float delta = t[x] - before[x];
+        out[x] = encodeTemperature(t[x]);
+        if (delta > HEAT_CHANGE_THRESHOLD || delta < -HEAT_CHANGE_THRESHOLD) {
+          changed |= 1 << (x - sx);
+        }
+      }
+
+      if (changed) {
+        int first = sx + __builtin_ctz(changed);
+        int last = sx + 31 - __builtin_clz(changed);
+        markRegionActive(world, planes.marks, first - 1, y - 1, last + 1, y + 1);
+      }
+    }
+  }
+}
+
+// ============================================================================
+// 다중 해상도 풀이: 공기는 블록 단위, 물질은 셀 단위
+// ----------------------------------------------------------------------------
+// 공기(EMPTY) 온도는 THERMAL_BLOCK_SIZE² 블록마다 값 하나(ThermalBlock::air)로 풀고,
+// 물질이 있는 블록의 물질 셀만 셀 단위로 풉니다.
+// - 공기-공기: 블록 경계에서 맞닿은 공기 셀 쌍 수에 비례해 블록끼리 교환
+//   (블록 중심 사이 거리만큼 기울기가 완만하므로 셀 단위보다 느림)
+// - 물질-물질: 명시적 풀이와 같은 규칙
+// - 물질-공기: 이웃 공기 셀 대신 그 블록의 온도를 쓰고, 물질 셀이 얻은 열
+//   (온도 변화 x 비열)을 블록 공기에서 빼므로 두 단계 사이에서 열이 보존됨.
+//   공기 쪽 전도가 느리므로 이 면에는 열전도율 가속을 적용하지 않음
+// 셀 평면의 공기 셀에는 블록 값을 기록하며, 값이 그대로인 블록은 건드리지 않습니다.
+// 다른 패스가 바꾼 공기 셀(입자가 떠난 자리, 폭발 열, 브러시)은 청크 더티 영역으로
+// 찾아 그 블록만 다시 평균냅니다 (마지막 기록값과 같은 셀은 float 블록 값 사용).
+// 바뀐 블록이 없고 교환이 멈춘 블록 행은 훑지 않습니다.
+// 작업 버퍼는 블록 테이블과 물질이 있는 블록만큼이므로 빈 공간이 많을수록 작고 빠릅니다.
+//
+// 셀 단위로 푸는 블록의 셀당 비용은 명시적 풀이보다 크므로, 그 블록이 전체의
+// 1/THERMAL_MULTIRES_MAX_FILL을 넘으면 명시적 풀이로 대신 풉니다 (블록 테이블은 비움).
+// 그동안은 점유 비트맵으로 물질이 있는 블록 범위를 세어, 절반 아래로 줄면
+// 블록 전체를 다시 읽어 다중 해상도로 돌아옵니다.
+// ============================================================================
+static_assert(CHUNK_SIZE % THERMAL_BLOCK_SIZE == 0, "thermal blocks must tile chunks");
+// 블록 사이 공기 온도 차가 이보다 작으면 교환하지 않음 (°C, 온도 평면 단위보다 훨씬 작음)
+const float THERMAL_AIR_EPSILON = 1.0f / 1024.0f;
+// 셀 단위로 푸는 블록이 전체의 1/이 값을 넘으면 명시적 풀이로 대신함
+const int THERMAL_MULTIRES_MAX_FILL = 8;
+
+// 블록 수 (가장자리 블록은 월드 밖 셀을 포함하지 않음)
+static int thermalBlockWidth(const World& world) {
+  return (world.width + THERMAL_BLOCK_SIZE - 1) / THERMAL_BLOCK_SIZE;
+}
+
+static int thermalBlockHeight(const World& world) {
+  return (world.height + THERMAL_BLOCK_SIZE - 1) / THERMAL_BLOCK_SIZE;
+}
+
+// 지난 풀이 이후 셀이 바뀌었을 수 있는 블록을 표시 (메인 스레드, 매 프레임)
+// 이번 프레임 처리 영역 + 지금까지 다음 프레임에 깨운 영역을 덮으면
+// 지난 열 전도 이후의 모든 변경을 포함함 (풀지 않는 프레임에도 쌓아 둠)
+static void trackThermalBlocks(World& world) {
+  if (world.thermalSolver != HEAT_SOLVER_MULTIRES || world.thermalExplicitFallback) {
+    // 다른 풀이가 바꾼 온도는 추적하지 않으므로, 다시 쓸 때 전체를 읽음
+    if (!world.thermalBlocks.empty()) {
+      world.thermalBlocks.clear();
+      world.thermalBlockRows.clear();
+      world.thermalFine.clear();
+    }
+    return;
+  }
+
+  int bw = thermalBlockWidth(world);
+  size_t count = static_cast<size_t>(bw) * thermalBlockHeight(world);
+  if (world.thermalBlocks.size() != count) {
+    ThermalBlock fresh = {};
+    fresh.dirty = 1;
+    world.thermalBlocks.assign(count, fresh);
+    ThermalBlockRow row = {};
+    row.dirty = 1;
+    world.thermalBlockRows.assign(thermalBlockHeight(world), row);
+    return;
+  }
+
+  for (int i = 0; i < world.chunkCount; i++) {
+    ChunkRect r = unionRect(world.chunkRects[i], world.nextChunkRects[i]);
+    if (isEmptyRect(r)) continue;
+    for (int by = r.minY / THERMAL_BLOCK_SIZE; by <= r.maxY / THERMAL_BLOCK_SIZE; by++) {
+      world.thermalBlockRows[by].dirty = 1;
+      ThermalBlock* row = &world.thermalBlocks[by * bw];
+      for (int bx = r.minX / THERMAL_BLOCK_SIZE; bx <= r.maxX / THERMAL_BLOCK_SIZE; bx++) {
+        row[bx].dirty = 1;
       }
     }
   }
 }
+
+// 블록의 공기/물질 셀 수와 공기 온도를 셀 평면에서 다시 읽음
+// 마지막 기록값 그대로인 공기 셀은 float 블록 값으로 세므로 1/8 °C 미만의 진행이 유지되고,
+// 새로 생긴 공기 셀(입자가 떠난 자리)이나 다른 패스가 바꾼 셀은 평균에 섞여 열이 보존됨
+// (블록은 이번 풀이 끝에 다시 기록되지만, 그 전까지 기록값도 새 평균으로 맞춤)
+static void refreshThermalBlock(const World& world, const HeatPlanes& planes,
+                                int bx, int by, ThermalBlock& block) {
+  int w = world.width;
+  int x0 = bx * THERMAL_BLOCK_SIZE;
+  int y0 = by * THERMAL_BLOCK_SIZE;
+  int x1 = x0 + THERMAL_BLOCK_SIZE < w ? x0 + THERMAL_BLOCK_SIZE : w;
+  int y1 = y0 + THERMAL_BLOCK_SIZE < world.height ? y0 + THERMAL_BLOCK_SIZE : world.height;
+
+  bool hadAir = block.airCells > 0;
+  float sum = 0.0f;
+  int air = 0;
+  for (int y = y0; y < y1; y++) {
+    // 모두 물질인 행 (블록 내부가 가득 찬 경우가 많음)
+    if (x1 - x0 == 4) {
+      uint32_t cells;
+      memcpy(&cells, &planes.type[getIndex(world, x0, y)], sizeof(cells));
+      if (((((cells & 0x7F7F7F7Fu) + 0x7F7F7F7Fu) | cells) & 0x80808080u) == 0x80808080u) {
+        continue;
+      }
+    }
+    for (int x = x0; x < x1; x++) {
+      int idx = getIndex(world, x, y);
+      bool isAir = planes.type[idx] == EMPTY;
+      float value = hadAir && planes.src[idx] == block.stored ? block.air : decodeTemperature(planes.src[idx]);
+      air += isAir;
+      sum += isAir ? value : 0.0f;
+    }
+  }
+  if (air > 0) {
+    block.air = sum / air;
+    block.stored = encodeTemperature(block.air);
+  }
+  block.airCells = static_cast<uint8_t>(air);
+  block.matterCells = static_cast<uint8_t>((x1 - x0) * (y1 - y0) - air);
+}
+
+// 블록 (bx, by)의 오른쪽/아래쪽 경계에서 맞닿은 공기-공기 셀 쌍 수
+static void linkThermalBlock(const World& world, const uint8_t* type, int bx, int by, ThermalBlock& block) {
+  int w = world.width;
+  int h = world.height;
+  int x0 = bx * THERMAL_BLOCK_SIZE;
+  int y0 = by * THERMAL_BLOCK_SIZE;
+  int x1 = x0 + THERMAL_BLOCK_SIZE < w ? x0 + THERMAL_BLOCK_SIZE : w;
+  int y1 = y0 + THERMAL_BLOCK_SIZE < h ? y0 + THERMAL_BLOCK_SIZE : h;
+
+  int right = 0;
+  if (x1 < w) {
+    for (int y = y0; y < y1; y++) {
+      right += type[getIndex(world, x1 - 1, y)] == EMPTY && type[getIndex(world, x1, y)] == EMPTY;
+    }
+  }
+  int down = 0;
+  if (y1 < h) {
+    for (int x = x0; x < x1; x++) {
+      down += type[getIndex(world, x, y1 - 1)] == EMPTY && type[getIndex(world, x, y1)] == EMPTY;
+    }
+  }
+  block.linkRight = static_cast<uint8_t>(right);
+  block.linkDown = static_cast<uint8_t>(down);
+}
+
+// 다중 해상도 풀이의 물질별 계수 (type 평면 값으로 바로 조회, 공기는 모두 0)
+struct MultiresCoefficients {
+  float faceRate[256];   // 물질-물질 면 계수 (명시적 풀이와 같음)
+  float airBias[256];    // 물질-공기 면 계수 - 물질-물질 면 계수
+  float airPull[256];    // 물질-공기 면에서 공기 온도 합이 받는 계수
+};
+
+// 블록 행을 풀 때 쓰는 행 1개 분량의 배열 (범위 양 끝 바깥 1칸은 고스트)
+// 블록 행 하나는 위아래 1행을 포함해 THERMAL_BAND_ROWS행이 필요하며, 행은 y로
+// 구별해 돌려 씀. 다음 블록 행과 겹치는 행은 두 블록 행의 범위를 모두 덮도록
+// 만들어 두므로, 제자리 갱신으로 평면이 바뀐 뒤에도 이전 값을 다시 읽지 않음
+const int THERMAL_BAND_ROWS = THERMAL_BLOCK_SIZE + 2;
+
+struct ThermalRow {
+  float* value;          // 셀 온도 (공기 셀은 블록의 기록값)
+  float* face;           // 물질-물질 면 계수
+  const uint8_t* type;   // 셀 타입 (x로 색인, loadTypeRow)
+  uint8_t* typeBuffer;   // 타일 배치에서 type을 모아 둘 자리
+  int y, x0, x1;         // 채운 행과 열 범위 [x0, x1)
+};
+
+// 행 y의 [x0, x1)을 채움 (월드 밖 행은 가장자리 행의 온도를 복사한 고스트)
+static void fillThermalRow(const World& world, const HeatPlanes& planes, const MultiresCoefficients& lut,
+                           int y, int x0, int x1, ThermalRow& row) {
+  int h = world.height;
+  int sy = y < 0 ? 0 : (y >= h ? h - 1 : y);
+  const uint8_t* type = loadTypeRow(world, planes.type, sy, x0, x1, row.typeBuffer);
+  const ThermalBlock* blocks = &world.thermalBlocks[(sy / THERMAL_BLOCK_SIZE) * thermalBlockWidth(world)];
+
+  decodePlaneRow(world, planes.src, sy, x0, x1, row.value);
+  for (int bx0 = x0; bx0 < x1; bx0 += THERMAL_BLOCK_SIZE) {
+    const ThermalBlock& block = blocks[bx0 / THERMAL_BLOCK_SIZE];
+    if (block.airCells == 0) continue;
+    float air = decodeTemperature(block.stored);
+    int end = bx0 + THERMAL_BLOCK_SIZE < x1 ? bx0 + THERMAL_BLOCK_SIZE : x1;
+    for (int x = bx0; x < end; x++) {
+      if (type[x] == EMPTY) row.value[x] = air;
+    }
+  }
+  for (int x = x0; x < x1; x++) {
+    row.face[x] = lut.faceRate[type[x]];
+  }
+
+  row.value[x0 - 1] = row.value[x0];
+  row.value[x1] = row.value[x1 - 1];
+  row.type = type;
+  row.y = y;
+  row.x0 = x0;
+  row.x1 = x1;
+}
+
+// 8칸의 type 중 EMPTY(0)인 칸의 바이트에 최상위 비트를 세움 (바이트 k = 셀 k, 리틀 엔디언)
+static inline uint64_t emptyLanes(const uint8_t* type) {
+  const uint64_t low7 = 0x7F7F7F7F7F7F7F7FULL;
+  uint64_t v;
+  memcpy(&v, type, sizeof(v));
+  return ~(((v & low7) + low7) | v) & ~low7;
+}
+
+static void conductHeatMultires(World& world, const HeatPlanes& planes, float dt) {
+  const ConductivityTable& table = getConductivity();
+  const float airCapacity = table.capacity[EMPTY];
+
+  // 물질-공기 면: 이웃 공기를 블록 값으로 보고, 물질 셀의 변화를 비열 비로
+  // 공기 온도 합에 환산 (비열이 공기보다 큰 물질은 공기 쪽이 과하게 변하지 않도록 면 계수를 줄임)
+  MultiresCoefficients lut;
+  for (int t = 0; t < 256; t++) {
+    float r = table.rate[t] * dt;
+    float plain = table.plainRate[t] * dt;
+    float ratio = airCapacity / table.capacity[t];
+    float airFace = (plain < HEAT_EXPLICIT_MAX_RATE ? plain : HEAT_EXPLICIT_MAX_RATE) * 0.25f *
+                    (ratio < 1.0f ? ratio : 1.0f);
+    lut.faceRate[t] = (r < HEAT_EXPLICIT_MAX_RATE ? r : HEAT_EXPLICIT_MAX_RATE) * 0.25f;
+    lut.airBias[t] = airFace - lut.faceRate[t];
+    lut.airPull[t] = airFace / ratio;
+  }
+  lut.faceRate[EMPTY] = 0.0f;
+  lut.airBias[EMPTY] = 0.0f;
+  lut.airPull[EMPTY] = 0.0f;
+
+  // 블록 사이 공기 셀 쌍 1개의 계수 (기울기는 블록 크기만큼 완만)
+  // 공기 셀 1개짜리 블록도 진동하지 않도록 전도율을 블록 크기로 자름
+  float airRate = table.rate[EMPTY] * dt;
+  if (airRate > THERMAL_BLOCK_SIZE) airRate = THERMAL_BLOCK_SIZE;
+  const float linkRate = airRate * 0.25f / THERMAL_BLOCK_SIZE;
+
+  int w = world.width;
+  int h = world.height;
+  int bw = thermalBlockWidth(world);
+  int bh = thermalBlockHeight(world);
+  ThermalBlock* blocks = world.thermalBlocks.data();
+  const uint8_t* type = planes.type;
+  const TemperatureValue* src = planes.src;
+  TemperatureValue* dst = planes.dst;
+
+  // 복사본에 풀 때는 바꾸지 않는 셀도 결과에 있어야 함 (고스트 포함 평면 전체)
+  if (dst != src) {
+    memcpy(dst - world.planeOrigin, src - world.planeOrigin, world.planeSize * sizeof(TemperatureValue));
+  }
+
+  // 블록 행마다: 바뀐 블록을 다시 읽고 (경계 쌍은 이웃 블록 쪽(왼쪽/위쪽)도 다시 셈),
+  // 물질이 있는 블록의 범위를 기록한 뒤, 다 읽은 윗 블록 행의 공기-공기 교환을 계산
+  // 교환은 블록 경계에서 맞닿은 공기 셀 쌍 수에 비례 (쌍이 있으면 양쪽 모두 공기 셀이 있음)
+  // 아주 작은 차이는 무시해 평형에 가까운 공기가 정확히 멈추게 함
+  // (계속 줄어드는 차이가 비정규 float가 되면 연산이 크게 느려짐)
+  // 바뀐 블록이 없는 행은 지난 범위를, 교환이 멈춘 행은 다시 계산하지 않음
+  ThermalBlockRow* rowState = world.thermalBlockRows.data();
+  for (int by = 0; by <= bh; by++) {
+    if (by < bh && rowState[by].dirty) {
+      ThermalBlockRow& row = rowState[by];
+      row.dirty = 0;
+      row.first = bw;
+      row.last = -1;
+      for (int bx = 0; bx < bw; bx++) {
+        ThermalBlock& block = blocks[by * bw + bx];
+        if (block.dirty) {
+          refreshThermalBlock(world, planes, bx, by, block);
+          linkThermalBlock(world, type, bx, by, block);
+          if (bx > 0 && !blocks[by * bw + bx - 1].dirty) {
+            linkThermalBlock(world, type, bx - 1, by, blocks[by * bw + bx - 1]);
+          }
+          if (by > 0 && !blocks[(by - 1) * bw + bx].dirty) {
+            linkThermalBlock(world, type, bx, by - 1, blocks[(by - 1) * bw + bx]);
+          }
+          row.pending = 1;
+          row.settled = 0;
+          if (by > 0) rowState[by - 1].settled = 0;
+        }
+        if (block.matterCells > 0) {
+          if (row.first == bw) row.first = bx;
+          row.last = bx;
+        }
+      }
+    }
+    if (by == 0 || rowState[by - 1].settled) continue;
+
+    bool flowing = false;
+    for (int i = (by - 1) * bw; i < by * bw; i++) {
+      ThermalBlock& block = blocks[i];
+      if (block.linkRight) {
+        float diff = blocks[i + 1].air - block.air;
+        if (diff > THERMAL_AIR_EPSILON || diff < -THERMAL_AIR_EPSILON) {
+          float flow = linkRate * block.linkRight * diff;
+          block.heat += flow;
+          blocks[i + 1].heat -= flow;
+          flowing = true;
+        }
+      }
+      if (block.linkDown) {
+        float diff = blocks[i + bw].air - block.air;
+        if (diff > THERMAL_AIR_EPSILON || diff < -THERMAL_AIR_EPSILON) {
+          float flow = linkRate * block.linkDown * diff;
+          block.heat += flow;
+          blocks[i + bw].heat -= flow;
+          flowing = true;
+        }
+      }
+    }
+    rowState[by - 1].settled = !flowing;
+    if (flowing) {
+      rowState[by - 1].pending = 1;
+      if (by < bh) rowState[by].pending = 1;
+    }
+  }
+
+  // 블록 행마다 처리할 셀 범위 [first, last] 블록과,
+  // 행 버퍼에 채울 범위 (좌우 이웃 셀을 읽도록 1블록씩 넓힘)
+  int matterBlocks = 0;
+  for (int by = 0; by < bh; by++) {
+    ThermalBlockRow& row = rowState[by];
+    int x0 = (row.first > 0 ? row.first - 1 : 0) * THERMAL_BLOCK_SIZE;
+    int x1 = (row.last + 2) * THERMAL_BLOCK_SIZE;
+    row.x0 = row.last < 0 ? 0 : x0;
+    row.x1 = row.last < 0 ? 0 : (x1 < w ? x1 : w);
+    matterBlocks += row.last < 0 ? 0 : row.last - row.first + 1;
+  }
+  world.thermalMatterBlocks = matterBlocks;
+
+  // 물질 셀을 행 단위로 풂 (공기 셀은 그대로)
+  // 1) 공기와 맞닿은 물질 셀: 그 면의 계수 보정값을 구하고 공기 블록에 열을 넘김
+  // 2) 모든 셀: 명시적 풀이와 같은 스텐실 + 보정값
+  //    (이웃 공기 셀은 블록의 기록값으로 읽고, 공기 셀은 면 계수가 0이라 바뀌지 않음)
+  int stride = w + 2;
+  world.thermalFine.resize(static_cast<size_t>(stride) * (THERMAL_BAND_ROWS * 2 + 1) + bw * 4);
+  float* buffer = world.thermalFine.data() + 1;   // x = -1 이 고스트
+  ThermalRow ring[THERMAL_BAND_ROWS];
+  for (int r = 0; r < THERMAL_BAND_ROWS; r++) {
+    ring[r].value = buffer + static_cast<size_t>(stride) * 2 * r;
+    ring[r].face = ring[r].value + stride;
+    ring[r].typeBuffer = world.thermalTypeRows.data() + static_cast<size_t>(w) * r;
+    ring[r].y = -2;
+  }
+  float* airFix = buffer + static_cast<size_t>(stride) * 2 * THERMAL_BAND_ROWS;
+  // 공기 블록이 한 행에서 받는 열을 면 방향별로 따로 모음
+  // (같은 블록에 연달아 더하는 의존 사슬을 4갈래로 나눔)
+  float* heatLeft = airFix + stride - 1;
+  float* heatRight = heatLeft + bw;
+  float* heatUp = heatRight + bw;
+  float* heatDown = heatUp + bw;
+
+  const SimdF32 four = simdSplat(4.0f);
+  const SimdF32 threshold = simdSplat(HEAT_CHANGE_THRESHOLD);
+  for (int by = 0; by < bh; by++) {
+    int fillX0 = rowState[by].x0;
+    int fillX1 = rowState[by].x1;
+    if (fillX0 >= fillX1) continue;
+    int x0 = rowState[by].first * THERMAL_BLOCK_SIZE;
+    int x1 = (rowState[by].last + 1) * THERMAL_BLOCK_SIZE < w ? (rowState[by].last + 1) * THERMAL_BLOCK_SIZE : w;
+    // 물질-공기 면의 열은 위아래 블록 행에도 들어감
+    for (int r = by > 0 ? by - 1 : 0; r <= by + 1 && r < bh; r++) {
+      rowState[r].pending = 1;
+    }
+    int y0 = by * THERMAL_BLOCK_SIZE;
+    int rows = h - y0 < THERMAL_BLOCK_SIZE ? h - y0 : THERMAL_BLOCK_SIZE;
+
+    // 윗 고스트 행은 윗 블록 행이 만들어 둔 것을 그대로 씀 (범위를 덮을 때)
+    // 나머지 행은 다음 블록 행의 범위까지 덮도록 만듦
+    int spanX0 = fillX0;
+    int spanX1 = fillX1;
+    if (by + 1 < bh && rowState[by + 1].x0 < rowState[by + 1].x1) {
+      if (rowState[by + 1].x0 < spanX0) spanX0 = rowState[by + 1].x0;
+      if (rowState[by + 1].x1 > spanX1) spanX1 = rowState[by + 1].x1;
+    }
+    ThermalRow* band[THERMAL_BAND_ROWS];
+    for (int r = 0; r <= rows + 1; r++) {
+      int y = y0 - 1 + r;
+      ThermalRow& row = ring[(y + THERMAL_BAND_ROWS) % THERMAL_BAND_ROWS];
+      if (row.y != y || row.x0 > fillX0 || row.x1 < fillX1) {
+        fillThermalRow(world, planes, lut, y, r == 0 ? fillX0 : spanX0, r == 0 ? fillX1 : spanX1, row);
+      }
+      band[r] = &row;
+    }
+
+    for (int r = 1; r <= rows; r++) {
+      int y = y0 - 1 + r;
+      const float* mid = band[r]->value;
+      const float* up = band[r - 1]->value;
+      const float* down = band[r + 1]->value;
+      const float* face = band[r]->face;
+      // 월드 밖 이웃은 자기 셀(물질)로 읽어 단열 (고스트 행 버퍼는 가장자리 행의 type)
+      int yUp = y > 0 ? y - 1 : y;
+      int yDown = y + 1 < h ? y + 1 : y;
+      const uint8_t* typeRow = band[r]->type;
+      const uint8_t* typeUp = band[r - 1]->type;
+      const uint8_t* typeDown = band[r + 1]->type;
+      ThermalBlock* blockRow = &blocks[by * bw];
+      ThermalBlock* blockUp = &blocks[(yUp / THERMAL_BLOCK_SIZE) * bw];
+      ThermalBlock* blockDown = &blocks[(yDown / THERMAL_BLOCK_SIZE) * bw];
+
+      // 공기와 맞닿은 물질 셀
+      int bx0 = rowState[by].first > 0 ? rowState[by].first - 1 : 0;
+      int bx1 = rowState[by].last + 2 < bw ? rowState[by].last + 2 : bw;
+      memset(airFix + x0, 0, (x1 - x0) * sizeof(float));
+      memset(heatLeft + bx0, 0, (bx1 - bx0) * sizeof(float));
+      memset(heatRight + bx0, 0, (bx1 - bx0) * sizeof(float));
+      memset(heatUp + bx0, 0, (bx1 - bx0) * sizeof(float));
+      memset(heatDown + bx0, 0, (bx1 - bx0) * sizeof(float));
+      // (분기 예측이 어려운 모양이 많아 네 면을 모두 계산하고 공기가 아닌 면은 0)
+      auto coupleAir = [&](int x) {
+        int t = typeRow[x];
+        int left = x > 0 ? x - 1 : x;
+        int right = x + 1 < w ? x + 1 : x;
+        float center = mid[x];
+        float dLeft = typeRow[left] == EMPTY ? mid[left] - center : 0.0f;
+        float dRight = typeRow[right] == EMPTY ? mid[right] - center : 0.0f;
+        float dUp = typeUp[x] == EMPTY ? up[x] - center : 0.0f;
+        float dDown = typeDown[x] == EMPTY ? down[x] - center : 0.0f;
+        float pull = lut.airPull[t];
+        heatLeft[left / THERMAL_BLOCK_SIZE] += pull * dLeft;
+        heatRight[right / THERMAL_BLOCK_SIZE] += pull * dRight;
+        heatUp[x / THERMAL_BLOCK_SIZE] += pull * dUp;
+        heatDown[x / THERMAL_BLOCK_SIZE] += pull * dDown;
+        airFix[x] = lut.airBias[t] * (dLeft + dRight + dUp + dDown);
+      };
+      // 8칸씩 type 바이트를 한 번에 검사해 맞닿은 셀만 처리
+      const uint64_t high = 0x8080808080808080ULL;
+      int x = x0;
+      for (; x + 8 <= x1; x += 8) {
+        uint64_t air = emptyLanes(typeRow + x);
+        uint64_t matter = ~air & high;
+        if (matter == 0) continue;
+        uint64_t near = (air << 8) | (air >> 8);
+        if (x > 0 && typeRow[x - 1] == EMPTY) near |= 0x80ULL;
+        if (x + 8 < w && typeRow[x + 8] == EMPTY) near |= 0x80ULL << 56;
+        near |= emptyLanes(typeUp + x) | emptyLanes(typeDown + x);
+        for (uint64_t cells = matter & near; cells != 0; cells &= cells - 1) {
+          coupleAir(x + (__builtin_ctzll(cells) >> 3));
+        }
+      }
+      for (; x < x1; x++) {
+        if (typeRow[x] != EMPTY) coupleAir(x);
+      }
+      for (int bx = bx0; bx < bx1; bx++) {
+        blockRow[bx].heat -= heatLeft[bx] + heatRight[bx];
+        blockUp[bx].heat -= heatUp[bx];
+        blockDown[bx].heat -= heatDown[bx];
+      }
+
+      // 청크 폭 단위로 처리하며, 온도가 크게 변한 셀의 범위만 깨움
+      for (int sx = x0; sx < x1; sx = (sx / CHUNK_SIZE + 1) * CHUNK_SIZE) {
+        int end = (sx / CHUNK_SIZE + 1) * CHUNK_SIZE < x1 ? (sx / CHUNK_SIZE + 1) * CHUNK_SIZE : x1;
+        int changed = 0;   // 비트 i = 셀 sx + i
+        int cx = sx;
+        TemperatureValue* out = &dst[getIndex(world, sx, y)] - sx;   // x로 색인 (이 구간만 유효)
+        for (; cx + SIMD_F32_LANES <= end; cx += SIMD_F32_LANES) {
+          SimdF32 center = simdLoad(mid + cx);
+          SimdF32 sum = simdAdd(simdAdd(simdLoad(up + cx), simdLoad(down + cx)),
+                                simdAdd(simdLoad(mid + cx - 1), simdLoad(mid + cx + 1)));
+          SimdF32 delta = simdAdd(simdMul(simdSub(sum, simdMul(center, four)), simdLoad(face + cx)),
+                                  simdLoad(airFix + cx));
+          storeTemperatureLanes(out + cx, simdAdd(center, delta));
+          changed |= simdMaskGreater(simdAbs(delta), threshold) << (cx - sx);
+        }
+        for (; cx < end; cx++) {
+          float center = mid[cx];
+          float delta = (up[cx] + down[cx] + mid[cx - 1] + mid[cx + 1] - 4.0f * center) * face[cx] + airFix[cx];
+          out[cx] = encodeTemperature(center + delta);
+          if (delta > HEAT_CHANGE_THRESHOLD || delta < -HEAT_CHANGE_THRESHOLD) {
+            changed |= 1 << (cx - sx);
+          }
+        }
+
+        if (changed) {
+          int first = sx + __builtin_ctz(changed);
+          int last = sx + 31 - __builtin_clz(changed);
+          markRegionActive(world, planes.marks, first - 1, y - 1, last + 1, y + 1);
+        }
+      }
+    }
+  }
+
+  // 공기 블록 갱신 (교환이 없고 다시 읽지 않은 블록은 셀 평면이 이미 같음)
+  // 공기가 바뀐 블록은 윗 행과의 교환과 자기 행의 교환을 다시 계산하게 함
+  for (int by = 0; by < bh; by++) {
+    if (!rowState[by].pending) continue;
+    rowState[by].pending = 0;
+    for (int bx = 0; bx < bw; bx++) {
+      ThermalBlock& block = blocks[by * bw + bx];
+      bool dirty = block.dirty;
+      block.dirty = 0;
+      if (block.airCells == 0 || (!dirty && block.heat == 0.0f))
+        continue;
+
+      rowState[by].settled = 0;
+      if (by > 0) rowState[by - 1].settled = 0;
+
+      float before = block.air;
+      block.air += block.heat / block.airCells;
+      block.heat = 0.0f;
+      TemperatureValue value = encodeTemperature(block.air);
+      if (!dirty && value == block.stored)
+        continue;
+
+      int x0 = bx * THERMAL_BLOCK_SIZE;
+      int y0 = by * THERMAL_BLOCK_SIZE;
+      int x1 = x0 + THERMAL_BLOCK_SIZE < w ? x0 + THERMAL_BLOCK_SIZE : w;
+      int y1 = y0 + THERMAL_BLOCK_SIZE < h ? y0 + THERMAL_BLOCK_SIZE : h;
+      bool changed = false;
+      for (int y = y0; y < y1; y++) {
+        for (int x = x0; x < x1; x++) {
+          int idx = getIndex(world, x, y);
+          bool isAir = type[idx] == EMPTY;
+          float delta = block.air - (dirty ? decodeTemperature(src[idx]) : before);
+          changed |= isAir && (delta > HEAT_CHANGE_THRESHOLD || delta < -HEAT_CHANGE_THRESHOLD);
+          dst[idx] = isAir ? value : dst[idx];
+        }
+      }
+      if (changed) {
+        markRegionActive(world, planes.marks, x0 - 1, y0 - 1, x1, y1);
+      }
+      block.stored = value;
+    }
+  }
+}
+
+// 다중 해상도 풀이가 셀 단위로 풀게 될 블록 수 (블록 행마다 물질이 있는 첫 블록 ~ 마지막 블록)
+// 셀 평면 대신 nextGrid의 점유 비트맵을 64칸씩 읽음 (메인 스레드)
+// limit을 넘으면 바로 돌려줌 (물질이 많은 월드에서 다 셀 필요가 없음)
+static int countThermalMatterBlocks(const World& world, int limit) {
+  int w = world.width;
+  int h = world.height;
+  int count = 0;
+  for (int y0 = 0; y0 < h; y0 += THERMAL_BLOCK_SIZE) {
+    int y1 = y0 + THERMAL_BLOCK_SIZE < h ? y0 + THERMAL_BLOCK_SIZE : h;
+    int first = -1;
+    int last = -1;
+    for (int x0 = 0; x0 < w; x0 += 64) {
+      int n = w - x0 < 64 ? w - x0 : 64;
+      uint64_t occupied = 0;
+      for (int y = y0; y < y1; y++) {
+        occupied |= loadOccupiedBits(world, world.nextGrid, y, x0, n);
+      }
+      if (occupied == 0) continue;
+      if (first < 0) first = x0 + __builtin_ctzll(occupied);
+      last = x0 + 63 - __builtin_clzll(occupied);
+    }
+    if (first >= 0) count += last / THERMAL_BLOCK_SIZE - first / THERMAL_BLOCK_SIZE + 1;
+    if (count > limit) break;
+  }
+  return count;
+}
+
+// 이번 풀이에 쓸 방식 (메인 스레드, 풀이하는 프레임마다)
+// 명시적 풀이로 대신하는 중이면 물질 블록이 기준의 절반 아래로 줄었을 때 다중 해상도로 돌아옴
+static HeatSolver selectThermalSolver(World& world) {
+  if (world.thermalSolver != HEAT_SOLVER_MULTIRES || !world.thermalExplicitFallback)
+    return world.thermalSolver;
+
+  int limit = thermalBlockWidth(world) * thermalBlockHeight(world) / (THERMAL_MULTIRES_MAX_FILL * 2);
+  if (countThermalMatterBlocks(world, limit) > limit)
+    return HEAT_SOLVER_EXPLICIT;
+
+  world.thermalExplicitFallback = false;
+  trackThermalBlocks(world);   // 블록 전체를 다시 읽도록 새로 만듦
+  return HEAT_SOLVER_MULTIRES;
+}
+
+// 풀이 방식에 따라 dt프레임 분량을 진행
+static void solveHeat(World& world, const HeatPlanes& planes, HeatSolver solver, float dt) {
+#ifdef POWDER_TILED_LAYOUT
+  // type 행을 모아 둘 버퍼 (다중 해상도 풀이는 행 버퍼마다 1행)
+  world.thermalTypeRows.resize(static_cast<size_t>(world.width) * THERMAL_BAND_ROWS);
+#endif
+  if (solver == HEAT_SOLVER_ADI) {
+    conductHeatImplicit(world, planes, dt);
+  } else if (solver == HEAT_SOLVER_MULTIRES) {
+    conductHeatMultires(world, planes, dt);
+    int blocks = thermalBlockWidth(world) * thermalBlockHeight(world);
+    world.thermalExplicitFallback = world.thermalMatterBlocks * THERMAL_MULTIRES_MAX_FILL > blocks;
+  } else {
+    conductHeatExplicit(world, planes, dt);
+  }
+  // 다른 풀이가 바꾼 온도는 청크 표시에 없으므로 다음 명시적 풀이는 전체를 풂
+  if (solver != HEAT_SOLVER_EXPLICIT) world.thermalChunkStep = 0.0f;
+}
+
+// thermalInterval 프레임마다 한 번 실행
+static bool isThermalFrame(const World& world) {
+  return world.thermalInterval <= 1 || world.frame % world.thermalInterval == 0;
+}
+
+static float thermalStep(const World& world) {
+  return world.thermalInterval > 1 ? static_cast<float>(world.thermalInterval) : 1.0f;
+}
+
+void updateHeatConduction(World& world) {
+  trackThermalBlocks(world);
+  trackThermalChunks(world);
+  if (!isThermalFrame(world))
+    return;
+
+  // 화학 반응 후의 타입 기준, 변화는 다음 프레임 테이블에 바로 기록
+  HeatPlanes planes = {
+    world.grid.temperature, world.grid.temperature,
+    world.nextGrid.type, world.nextChunkRects.data()
+  };
+  solveHeat(world, planes, selectThermalSolver(world), thermalStep(world));
+}
+
+// (작업 스레드) 결과를 복사본 대비 변화량으로 바꾸고 행별로 변화가 있는지 기록
+// 합칠 때 현재 값에 변화량만 더하므로, 작업 중에 반응 열이나 브러시로
+// 바뀐 온도가 덮어써지지 않음
+static void storeThermalDelta(World& world) {
+  const TemperatureValue* before = world.thermalSnapshot.data() + world.planeOrigin;
+  TemperatureValue* delta = world.thermalResult.data() + world.planeOrigin;
+  for (int y = 0; y < world.height; y++) {
+    bool changed = false;
+    forEachRowRun(world, y, 0, world.width, [&](int, int idx, int count) {
+      for (int i = idx; i < idx + count; i++) {
+        delta[i] = static_cast<TemperatureValue>(delta[i] - before[i]);
+        changed |= delta[i] != 0;
+      }
+    });
+    world.thermalRowChanged[y] = changed;
+  }
+}
+
+void startHeatConductionAsync(World& world) {
+  if (world.thermalWorker == nullptr)
+    return;
+  trackThermalBlocks(world);
+  if (!isThermalFrame(world))
+    return;
+
+  // 작업 스레드가 읽고 쓸 복사본 (고스트 포함 평면과 같은 배치, 월드 크기가 바뀌면 다시 할당)
+  size_t size = static_cast<size_t>(world.planeSize);
+  if (world.thermalSnapshot.size() != size) {
+    world.thermalSnapshot.resize(size);
+    world.thermalResult.resize(size);
+    world.thermalTypes.resize(size);
+  }
+  // 평면 크기가 같아도 행 수는 다를 수 있음 (70x66 → 40x100)
+  if (world.thermalRowChanged.size() != static_cast<size_t>(world.height)) {
+    world.thermalRowChanged.resize(world.height);
+  }
+  if (world.thermalChunkRects.size() != static_cast<size_t>(world.chunkCount)) {
+    world.thermalChunkRects.resize(world.chunkCount);
+    clearChunkRects(world, world.thermalChunkRects.data(), world.chunkCount);
+  }
+
+  memcpy(world.thermalSnapshot.data(), world.temperature.data(), size * sizeof(TemperatureValue));
+  memcpy(world.thermalTypes.data(), world.nextGrid.type - world.planeOrigin, size);
+
+  HeatPlanes planes = {
+    world.thermalSnapshot.data() + world.planeOrigin, world.thermalResult.data() + world.planeOrigin,
+    world.thermalTypes.data() + world.planeOrigin, world.thermalChunkRects.data()
+  };
+  // 풀이 설정은 시작 시점 값으로 고정 (작업 중에 바뀌어도 영향 없음)
+  World* target = &world;
+  HeatSolver solver = selectThermalSolver(world);
+  float dt = thermalStep(world);
+  world.thermalPending = true;
+  world.thermalWorker->run([target, planes, solver, dt] {
+    solveHeat(*target, planes, solver, dt);
+    storeThermalDelta(*target);
+  });
+}
+
+// 변화량을 현재 값에 더함 (int16은 범위에서 포화)
+static inline TemperatureValue applyThermalDelta(TemperatureValue current, TemperatureValue delta) {
+#ifdef POWDER_TEMPERATURE_FP32
+  return current + delta;
+#else
+  int v = current + delta;
+  if (v > 32767) v = 32767;
+  if (v < -32768) v = -32768;
+  return static_cast<TemperatureValue>(v);
+#endif
+}
+
+void finishHeatConductionAsync(World& world) {
+  if (!world.thermalPending)
+    return;
+
+  world.thermalWorker->wait();
+  world.thermalPending = false;
+
+  // 작업 시작 후 이동/상태 전이로 셀의 입자가 바뀌었을 수 있음 (온도는 입자와 함께 이동)
+  // 변화량이 다른 입자에 더해지지 않도록 type이 시작 시점과 같은 셀에만 더함
+  // (바뀐 셀의 변화량은 버림: 움직이는 입자는 비동기 모드에서 그 프레임의 전도를 놓침)
+  TemperatureValue* plane = world.grid.temperature;
+  const uint8_t* type = world.grid.type;
+  const uint8_t* typeBefore = world.thermalTypes.data() + world.planeOrigin;
+  const TemperatureValue* delta = world.thermalResult.data() + world.planeOrigin;
+  for (int y = 0; y < world.height; y++) {
+    if (!world.thermalRowChanged[y])
+      continue;
+
+    forEachRowRun(world, y, 0, world.width, [&](int, int idx, int count) {
+      for (int i = idx; i < idx + count; i++) {
+        if (type[i] == typeBefore[i]) plane[i] = applyThermalDelta(plane[i], delta[i]);
+      }
+    });
+  }
+
+  mergeChunkRects(world, world.thermalChunkRects.data());
+}
@@ -1,9 +1,22 @@
 #ifndef HEAT_CONDUCTION_H
 #define HEAT_CONDUCTION_H
 
+#include "../core/world.h"
+
 // PASS 2: 열 전도 (Heat Conduction)
 // 주변 셀과의 온도 차이를 기반으로 열을 전달합니다.
 // 비열이 높을수록 온도 변화가 느립니다.
-void updateHeatConduction();
+void updateHeatConduction(World& world);
+
+// 비동기 모드 (world.thermalWorker가 있을 때 stepWorld가 사용)
+// 프레임 N의 온도/type 평면을 복사해 작업 스레드에서 열 전도를 시작하고,
+// 프레임 N+1 시작 시 결과를 합침 (한 프레임 늦게 반영)
+
+// 현재 온도 평면과 nextGrid의 type 평면을 복사해 작업 시작
+void startHeatConductionAsync(World& world);
+
+// 진행 중인 작업을 기다려 온도 변화량을 더하고 깨울 영역을 다음 프레임에 합침
+// 작업이 없으면 아무것도 안 함 (thermalWorker를 바꾸기 전에도 호출)
+void finishHeatConductionAsync(World& world);
 
 #endif // HEAT_CONDUCTION_H
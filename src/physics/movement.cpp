@@ -1,306 +1,316 @@
 #include "movement.h"
 #include "../core/grid.h"
+#include "../core/occupancy.h"
 #include "../core/types.h"
-#include "../material_db.h"
+#include "../materials/material_table.h"
+#include "../core/thread_pool.h"
 #include <cstdlib>
+#include <vector>
+
+// 병렬 모드에서 입자가 자기 청크 밖으로 이동할 수 있는 최대 거리
+static const int PARALLEL_MAX_REACH = CHUNK_SIZE / 2;
+
+// 상태별 최대 수평 확산 거리
+// 확산은 막힌 칸을 건너뛰며 더 먼 칸도 검사하므로 고스트 폭 안이어야 함
+static const int FIRE_DISPERSION = 3;
+static const int LIQUID_DISPERSION = 10;
+static const int GAS_DISPERSION = 5;
+static_assert(LIQUID_DISPERSION <= GHOST_X && GAS_DISPERSION <= GHOST_X && FIRE_DISPERSION <= GHOST_X,
+              "horizontal probes must stay inside the ghost border");
 
 // 헬퍼 함수: 빈 공간 또는 밀도가 낮은지 체크
-static bool canMoveTo(int x, int y, float myDensity) {
-  if (!inBounds(x, y))
-    return false;
+// movable은 이동하는 입자의 MaterialTable::displace 행 (빈 셀/고체/밀도 규칙을 미리 합친 것)
+// 월드 밖은 고스트 WALL(고체)이므로 항상 막힘
+static inline bool canMoveTo(const World& world, int x, int y, uint32_t movable) {
+  // 이동 판정에는 type 평면만 필요
+  return (movable >> world.grid.type[getIndex(world, x, y)]) & 1u;
+}
+
+// ============================================================================
+// 상태별 이동 커널
+// ----------------------------------------------------------------------------
+// 상태마다 하나의 템플릿 커널을 특성(traits) 구조체로 특수화합니다.
+// 세로 방향, 확산 거리, 난수 사용 방식이 모두 컴파일 타임 상수이므로
+// 커널 안에 상태 분기가 남지 않습니다. 모든 이동은 moveTo() 하나를 거칩니다.
+// 난수를 뽑는 순서는 커널마다 고정되어 있어 결과가 재현됩니다.
+// ============================================================================
+
+// 입자 1개를 이동시키는 동안 필요한 값
+struct MoveContext {
+  World& world;
+  ChunkRect* marks;   // 다음 프레임에 깨울 영역 테이블
+  Rng& rng;
+  uint32_t movable;   // 이동하는 입자의 MaterialTable::displace 행
+  const uint8_t* ranks;  // MaterialTable::rank (점유 비트맵 갱신용)
+  int rank;           // 이동하는 입자의 순위 (수평 확산 검색용)
+  bool shared;        // 병렬 이동 중 (점유 비트맵 워드를 다른 작업자와 공유)
+  int maxReach;       // 수평 확산 최대 거리
+  int idx;
+  int x, y;
+};
+
+// 공통 이동 처리: (tx, ty)와 자리를 바꾸고 두 셀의 청크를 깨움
+static inline void moveTo(MoveContext& c, int tx, int ty) {
+  int toIdx = getIndex(c.world, tx, ty);
+  int diff = c.rank ^ c.ranks[c.world.nextGrid.type[toIdx]];
+  swapCells(c.world.nextGrid, c.idx, toIdx);
+  swapOccupancy(c.world, c.world.nextGrid, c.x, c.y, tx, ty, diff, c.shared);
+  c.world.nextGrid.moved_epoch[toIdx] = c.world.frameEpoch;
+  markChunkActive(c.world, c.marks, c.x, c.y);
+  markChunkActive(c.world, c.marks, tx, ty);
+}
+
+// (tx, ty)로 갈 수 있으면 이동
+static inline bool tryMove(MoveContext& c, int tx, int ty) {
+  if (!canMoveTo(c.world, tx, ty, c.movable)) return false;
+  moveTo(c, tx, ty);
+  return true;
+}
+
+// dir 방향으로 1칸부터 reach칸까지 중 가장 가까운 이동 가능 칸으로 수평 이동
+// 막힌 칸은 건너뛰며, 칸마다 검사하는 대신 점유 비트맵에서 한 번에 찾음
+// both: 그쪽이 막혔으면 반대 방향도 같은 창에서 찾음
+static inline bool trySlide(MoveContext& c, int dir, int reach, bool both) {
+  if (reach <= 0) return false;
+  uint64_t window = loadSlideWindow(c.world, c.world.grid, c.x, c.y, reach, c.rank);
+  if (window == 0) return false;
+  int dist = findNearestInWindow(window, reach, dir);
+  if (dist == 0 && both) {
+    dir = -dir;
+    dist = findNearestInWindow(window, reach, dir);
+  }
+  if (dist == 0) return false;
+  moveTo(c, c.x + dir * dist, c.y);
+  return true;
+}
+
+static inline void dampVelocity(MoveContext& c) {
+  CellPlanes& cells = c.world.nextGrid;
+  setVx(cells, c.idx, getVx(cells, c.idx) * VELOCITY_DAMPING);
+  setVy(cells, c.idx, getVy(cells, c.idx) * VELOCITY_DAMPING);
+}
+
+// 특성 구조체 필드
+//   FALL             : 세로 이동 방향 (+1 아래, -1 위)
+//   FALL_CHANCE      : 10번 중 세로 이동을 시도하는 횟수 (10이면 난수를 뽑지 않음)
+//   EAGER_SIDE       : 세로 직진을 시도하기 전에 대각선 방향을 뽑음
+//   INERTIA          : |vx|가 있으면 대각선/확산 방향을 vx 부호로 정함
+//   DISPERSION       : 수평 확산 거리 (0이면 확산 없음)
+//   SLIDE_SAME_SIDE  : 대각선이 막히면 같은 방향부터 확산 (아니면 방향을 새로 뽑음)
+
+// POWDER: 아래로 떨어짐 + 랜덤 대각선
+struct PowderTraits {
+  static const int FALL = 1;
+  static const int FALL_CHANCE = 10;
+  static const bool EAGER_SIDE = false;
+  static const bool INERTIA = false;
+  static const int DISPERSION = 0;
+  static const bool SLIDE_SAME_SIDE = false;
+};
+
+// LIQUID: 아래 + 관성 방향 대각선 + 좌우로 퍼짐
+struct LiquidTraits {
+  static const int FALL = 1;
+  static const int FALL_CHANCE = 10;
+  static const bool EAGER_SIDE = false;
+  static const bool INERTIA = true;
+  static const int DISPERSION = LIQUID_DISPERSION;
+  static const bool SLIDE_SAME_SIDE = true;
+};
+
+// GAS: 70% 확률로 위로 올라감, 못 가면 좌우로 퍼짐
+struct GasTraits {
+  static const int FALL = -1;
+  static const int FALL_CHANCE = 7;
+  static const bool EAGER_SIDE = true;
+  static const bool INERTIA = false;
+  static const int DISPERSION = GAS_DISPERSION;
+  static const bool SLIDE_SAME_SIDE = false;
+};
+
+// FIRE: 아래 특수화만 사용
+struct FireTraits {
+  static const int FALL = -1;
+  static const int DISPERSION = FIRE_DISPERSION;
+};
+
+template <typename Traits>
+static inline int pickSide(MoveContext& c) {
+  if (Traits::INERTIA) {
+    float vx = getVx(c.world.nextGrid, c.idx);
+    if (std::abs(vx) > 0.1f) return (vx > 0) ? 1 : -1;
+  }
+  return c.rng.nextSign();
+}
+
+// 일반 커널: 세로 직진 → 대각선 2개 → 수평 확산, 못 움직이면 속도 감쇠
+template <typename Traits>
+static void moveKernel(MoveContext& c) {
+  const int fallY = c.y + Traits::FALL;
+  const int reach = c.maxReach < Traits::DISPERSION ? c.maxReach : Traits::DISPERSION;
+  
+  if (Traits::FALL_CHANCE >= 10 || c.rng.nextInt(10) < Traits::FALL_CHANCE) {
+    int side = Traits::EAGER_SIDE ? c.rng.nextSign() : 0;
+    if (tryMove(c, c.x, fallY)) return;
+    if (!Traits::EAGER_SIDE) side = pickSide<Traits>(c);
+    if (tryMove(c, c.x + side, fallY) || tryMove(c, c.x - side, fallY)) return;
+    
+    if (Traits::DISPERSION > 0 && Traits::SLIDE_SAME_SIDE) {
+      // 반대 방향도 시도 (vx가 있어도 막히면 반대로 갈 수 있어야 함)
+      if (trySlide(c, side, reach, true)) return;
+      dampVelocity(c);
+      return;
+    }
+  }
   
-  const Particle& target = grid[getIndex(x, y)];
-  if (target.type == EMPTY)
-    return true;
+  if (Traits::DISPERSION > 0 && !Traits::SLIDE_SAME_SIDE) {
+    if (trySlide(c, c.rng.nextSign(), reach, true)) return;
+  }
+  dampVelocity(c);
+}
+
+// FIRE: 위 → 랜덤 대각선/옆 1칸 → 한쪽으로만 확산, 속도 감쇠 없음
+template <>
+void moveKernel<FireTraits>(MoveContext& c) {
+  const int upY = c.y + FireTraits::FALL;
+  int randomDir = c.rng.nextInt(3) - 1; // -1, 0, 1
   
-  // 고체(Solid)는 밀어낼 수 없음
-  if (target.state == STATE_SOLID)
-    return false;
+  if (tryMove(c, c.x, upY)) return;
+  if (randomDir != 0 && tryMove(c, c.x + randomDir, upY)) return;
+  // randomDir == 0이면 제자리 검사: 이번 프레임에 생긴 불(grid에서는 빈 칸)은 여기서 멈춤
+  if (tryMove(c, c.x + randomDir, c.y)) return;
   
-  const Material& targetMat = getMaterial(target.type);
-  return myDensity > targetMat.density;
+  // 갇히는 것 방지용 확산, 반대 방향은 다음 프레임에 시도
+  int reach = c.maxReach < FireTraits::DISPERSION ? c.maxReach : FireTraits::DISPERSION;
+  trySlide(c, c.rng.nextSign(), reach, false);
 }
 
-void updateMovement() {
-  // 아래에서 위로, 랜덤 좌우 순서로 순회
-  for (int y = HEIGHT - 1; y >= 0; y--) {
-    bool leftToRight = (rand() % 2) == 0;
-    
-    int startX = leftToRight ? 0 : WIDTH - 1;
-    int endX = leftToRight ? WIDTH : -1;
-    int stepX = leftToRight ? 1 : -1;
+// 커널 표: 물리 상태로 인덱싱, FIRE는 기체 상태지만 별도 칸 사용
+typedef void (*MoveKernel)(MoveContext&);
+static const int KERNEL_FIRE = 4;
+static const MoveKernel MOVE_KERNELS[5] = {
+  nullptr,                     // STATE_SOLID: 움직이지 않음
+  moveKernel<PowderTraits>,    // STATE_POWDER
+  moveKernel<LiquidTraits>,    // STATE_LIQUID
+  moveKernel<GasTraits>,       // STATE_GAS
+  moveKernel<FireTraits>,      // KERNEL_FIRE
+};
+
+// 셀 (x, y)에 있는 입자 1개의 이동 처리
+// marks: 다음 프레임에 깨울 영역을 기록할 테이블, maxReach: 수평 확산 최대 거리
+// shared: 병렬 이동 중인지
+static inline void moveParticle(World& world, const MaterialTable& table, ChunkRect* marks, int maxReach,
+                                bool shared, Rng& rng, int x, int y) {
+  int idx = getIndex(world, x, y);
+  int type = world.nextGrid.type[idx];
+  
+  if (type == EMPTY || type == WALL) return;
+  if (world.nextGrid.moved_epoch[idx] == world.frameEpoch) return;
+  
+  MoveKernel kernel = MOVE_KERNELS[type == FIRE ? KERNEL_FIRE : world.nextGrid.state[idx]];
+  if (kernel == nullptr) return;
+  
+  MoveContext c = { world, marks, rng, table.displace[type], table.rank, table.rank[type], shared,
+                    maxReach, idx, x, y };
+  kernel(c);
+}
+
+// 행 y의 [x0, x1] 구간 이동 (구간 폭은 청크 폭 이하)
+// 빈 셀은 점유 비트맵으로 건너뜀. 처리 도중 구간 안에 새로 들어온 입자는 모두
+// 이번 프레임에 이미 이동한 입자이므로, 시작할 때 읽은 비트만 순회해도 결과가 같음
+static inline void moveRowSpan(World& world, const MaterialTable& table, ChunkRect* marks, int maxReach,
+                               bool shared, Rng& rng, int x0, int x1, int y, bool leftToRight) {
+  uint64_t occupied = loadOccupiedBits(world, world.nextGrid, y, x0, x1 - x0 + 1);
+  if (leftToRight) {
+    while (occupied != 0) {
+      int i = __builtin_ctzll(occupied);
+      occupied &= occupied - 1;
+      moveParticle(world, table, marks, maxReach, shared, rng, x0 + i, y);
+    }
+  } else {
+    while (occupied != 0) {
+      int i = 63 - __builtin_clzll(occupied);
+      occupied &= ~(1ull << i);
+      moveParticle(world, table, marks, maxReach, shared, rng, x0 + i, y);
+    }
+  }
+}
+
+// 순차 이동: 아래에서 위로, 행마다 랜덤 좌우 순서로 순회
+static void updateMovementSerial(World& world) {
+  ChunkRect* marks = world.nextChunkRects.data();
+  const MaterialTable& table = getMaterialTable();
+  
+  for (int y = world.height - 1; y >= 0; y--) {
+    Rng rowRng = worldStreamRng(world, RNG_PASS_MOVEMENT, y, RNG_ROW_STREAM);
+    bool leftToRight = (rowRng.next() & 1u) == 0;
     
-    for (int x = startX; x != endX; x += stepX) {
-      int idx = getIndex(x, y);
-      Particle& p = nextGrid[idx];
-      
-      if (p.type == EMPTY || p.type == WALL) continue;
-      if (p.updated_this_frame) continue;
-      
-      const Material& mat = getMaterial(p.type);
+    // 깨어 있는 청크의 더티 구간만 처리 (행 방향은 유지)
+    for (int i = 0; i < world.chunkWidth; i++) {
+      int cx = leftToRight ? i : world.chunkWidth - 1 - i;
+      int x0, x1;
+      if (!getChunkRowSpan(world, cx, y, x0, x1)) continue;
       
-      // 일반 고체는 움직이지 않음
-      if (p.state == STATE_SOLID) continue;
-      
-      // FIRE: 위로 올라감 + 랜덤 움직임
-      if (p.type == FIRE) {
-        bool fireMoved = false;
-        // 랜덤 방향 추가
-        int randomDir = rand() % 3 - 1; // -1, 0, 1
-        
-        // 1. 위로 이동 시도 (직진 또는 대각선)
-        if (canMoveTo(x, y - 1, mat.density)) {
-          int toIdx = getIndex(x, y - 1);
-          Particle temp = nextGrid[idx];
-          nextGrid[idx] = nextGrid[toIdx];
-          nextGrid[toIdx] = temp;
-          nextGrid[toIdx].updated_this_frame = true;
-          markChunkActive(x, y);
-          markChunkActive(x, y - 1);
-          fireMoved = true;
-        } else if (randomDir != 0 && canMoveTo(x + randomDir, y - 1, mat.density)) {
-          int toIdx = getIndex(x + randomDir, y - 1);
-          Particle temp = nextGrid[idx];
-          nextGrid[idx] = nextGrid[toIdx];
-          nextGrid[toIdx] = temp;
-          nextGrid[toIdx].updated_this_frame = true;
-          markChunkActive(x, y);
-          markChunkActive(x + randomDir, y - 1);
-          fireMoved = true;
-        } else if (canMoveTo(x + randomDir, y, mat.density)) { // 2. 랜덤 좌우 이동 시도 (1칸)
-          int toIdx = getIndex(x + randomDir, y);
-          Particle temp = nextGrid[idx];
-          nextGrid[idx] = nextGrid[toIdx];
-          nextGrid[toIdx] = temp;
-          nextGrid[toIdx].updated_this_frame = true;
-          markChunkActive(x, y);
-          markChunkActive(x + randomDir, y);
-          fireMoved = true;
-        }
-        
-        // 3. 이동 실패 시 수평 확산 (Slide) 시도 - 불이 갇히는 것 방지
-        if (!fireMoved) {
-            int horizDir = (rand() % 2) * 2 - 1; // -1 또는 1
-            int fireDispersion = 3; // 불은 기체보다 덜 퍼지지만 어느 정도 미끄러져야 함
-            
-            for (int dist = 1; dist <= fireDispersion; dist++) {
-              if (canMoveTo(x + horizDir * dist, y, mat.density)) {
-                int toIdx = getIndex(x + horizDir * dist, y);
-                Particle temp = nextGrid[idx];
-                nextGrid[idx] = nextGrid[toIdx];
-                nextGrid[toIdx] = temp;
-                nextGrid[toIdx].updated_this_frame = true;
-                markChunkActive(x, y);
-                markChunkActive(x + horizDir * dist, y);
-                break;
-              }
-            }
-            // 반대 방향 시도 생략 (성능 고려, 다음 프레임에 시도)
-        }
-        continue;
-      }
-      
-      
-      // 일반 물질 이동
-      bool moved = false;
-      
-      // 속도 기반 목표 위치 계산
-      int targetY = y + (int)p.vy;
-      int targetX = x + (int)p.vx;
-      
-      // POWDER: 아래로 떨어짐 + 랜덤 좌우 움직임
-      if (p.state == STATE_POWDER) {
-        if (canMoveTo(x, y + 1, mat.density)) {
-          int toIdx = getIndex(x, y + 1);
-          Particle temp = nextGrid[idx];
-          nextGrid[idx] = nextGrid[toIdx];
-          nextGrid[toIdx] = temp;
-          nextGrid[toIdx].updated_this_frame = true;
-          moved = true;
-          markChunkActive(x, y);
-          markChunkActive(x, y + 1);
-        } else {
-          // 대각선 방향 랜덤 선택
-          int dir = (rand() % 2) * 2 - 1; // -1 또는 1
-          if (canMoveTo(x + dir, y + 1, mat.density)) {
-            int toIdx = getIndex(x + dir, y + 1);
-            Particle temp = nextGrid[idx];
-            nextGrid[idx] = nextGrid[toIdx];
-            nextGrid[toIdx] = temp;
-            nextGrid[toIdx].updated_this_frame = true;
-            moved = true;
-            markChunkActive(x, y);
-            markChunkActive(x + dir, y + 1);
-          } else if (canMoveTo(x - dir, y + 1, mat.density)) {
-            int toIdx = getIndex(x - dir, y + 1);
-            Particle temp = nextGrid[idx];
-            nextGrid[idx] = nextGrid[toIdx];
-            nextGrid[toIdx] = temp;
-            nextGrid[toIdx].updated_this_frame = true;
-            moved = true;
-            markChunkActive(x, y);
-            markChunkActive(x - dir, y + 1);
-          }
-        }
-      }
-      // LIQUID: 아래 + 좌우로 퍼짐 (향상된 확산)
-      else if (p.state == STATE_LIQUID) {
-        if (canMoveTo(x, y + 1, mat.density)) {
-          int toIdx = getIndex(x, y + 1);
-          Particle temp = nextGrid[idx];
-          nextGrid[idx] = nextGrid[toIdx];
-          nextGrid[toIdx] = temp;
-          nextGrid[toIdx].updated_this_frame = true;
-          moved = true;
-          markChunkActive(x, y);
-          markChunkActive(x, y + 1);
-        } else {
-          // 이동 방향 결정 (vx가 있으면 관성 따름, 없으면 랜덤)
-          int preferredDir = 0;
-          if (std::abs(p.vx) > 0.1f) {
-            preferredDir = (p.vx > 0) ? 1 : -1;
-          } else {
-            preferredDir = (rand() % 2) * 2 - 1; // -1 또는 1
-          }
+      // 청크 행마다 독립 스트림
+      Rng rng = worldStreamRng(world, RNG_PASS_MOVEMENT, y, cx);
+      moveRowSpan(world, table, marks, world.width, false, rng, x0, x1, y, leftToRight);
+    }
+  }
+}
 
-          // 대각선 이동 시도 (선호 방향 우선)
-          if (canMoveTo(x + preferredDir, y + 1, mat.density)) {
-            int toIdx = getIndex(x + preferredDir, y + 1);
-            Particle temp = nextGrid[idx];
-            nextGrid[idx] = nextGrid[toIdx];
-            nextGrid[toIdx] = temp;
-            nextGrid[toIdx].updated_this_frame = true;
-            moved = true;
-            markChunkActive(x, y);
-            markChunkActive(x + preferredDir, y + 1);
-          } else if (canMoveTo(x - preferredDir, y + 1, mat.density)) { // 반대쪽 대각선
-            int toIdx = getIndex(x - preferredDir, y + 1);
-            Particle temp = nextGrid[idx];
-            nextGrid[idx] = nextGrid[toIdx];
-            nextGrid[toIdx] = temp;
-            nextGrid[toIdx].updated_this_frame = true;
-            moved = true;
-            markChunkActive(x, y);
-            markChunkActive(x - preferredDir, y + 1);
-          } else {
-            // 수평 확산
-            int horizDir = preferredDir;
-            int dispersionRate = 10; 
-            
-            for (int dist = 1; dist <= dispersionRate; dist++) {
-              if (canMoveTo(x + horizDir * dist, y, mat.density)) {
-                int toIdx = getIndex(x + horizDir * dist, y);
-                Particle temp = nextGrid[idx];
-                nextGrid[idx] = nextGrid[toIdx];
-                nextGrid[toIdx] = temp;
-                nextGrid[toIdx].updated_this_frame = true;
-                moved = true;
-                markChunkActive(x, y);
-                markChunkActive(x + horizDir * dist, y);
-                break;
-              }
-            }
-            
-            // 반대 방향도 시도 (vx가 있어도 막히면 반대로 갈 수 있어야 함)
-            if (!moved) {
-              for (int dist = 1; dist <= dispersionRate; dist++) {
-                if (canMoveTo(x - horizDir * dist, y, mat.density)) {
-                  int toIdx = getIndex(x - horizDir * dist, y);
-                  Particle temp = nextGrid[idx];
-                  nextGrid[idx] = nextGrid[toIdx];
-                  nextGrid[toIdx] = temp;
-                  nextGrid[toIdx].updated_this_frame = true;
-                  moved = true;
-                  markChunkActive(x, y);
-                  markChunkActive(x - horizDir * dist, y);
-                  break;
-                }
-              }
-            }
-          }
-        }
-      }
-      // GAS: 위로 올라감 + 랜덤 확산
-      else if (p.state == STATE_GAS) {
-        // 랜덤 움직임 방향 선택
-        int randomChoice = rand() % 10;
-        
-        // 70% 확률로 위로 이동
-        if (randomChoice < 7) {
-          int diagDir = (rand() % 2) * 2 - 1; // -1 또는 1
-          
-          if (canMoveTo(x, y - 1, mat.density)) {
-            int toIdx = getIndex(x, y - 1);
-            Particle temp = nextGrid[idx];
-            nextGrid[idx] = nextGrid[toIdx];
-            nextGrid[toIdx] = temp;
-            nextGrid[toIdx].updated_this_frame = true;
-            moved = true;
-            markChunkActive(x, y);
-            markChunkActive(x, y - 1);
-          } else if (canMoveTo(x + diagDir, y - 1, mat.density)) {
-            int toIdx = getIndex(x + diagDir, y - 1);
-            Particle temp = nextGrid[idx];
-            nextGrid[idx] = nextGrid[toIdx];
-            nextGrid[toIdx] = temp;
-            nextGrid[toIdx].updated_this_frame = true;
-            moved = true;
-            markChunkActive(x, y);
-            markChunkActive(x + diagDir, y - 1);
-          } else if (canMoveTo(x - diagDir, y - 1, mat.density)) {
-            int toIdx = getIndex(x - diagDir, y - 1);
-            Particle temp = nextGrid[idx];
-            nextGrid[idx] = nextGrid[toIdx];
-            nextGrid[toIdx] = temp;
-            nextGrid[toIdx].updated_this_frame = true;
-            moved = true;
-            markChunkActive(x, y);
-            markChunkActive(x - diagDir, y - 1);
-          }
-        }
-        
-        // 이동하지 못했으면 수평 확산
-        if (!moved) {
-          int horizDir = (rand() % 2) * 2 - 1; // -1 또는 1
-          int dispersionRate = 5; // 기체 확산 거리 증가 (2 -> 5)
-          
-          for (int dist = 1; dist <= dispersionRate; dist++) {
-            if (canMoveTo(x + horizDir * dist, y, mat.density)) {
-              int toIdx = getIndex(x + horizDir * dist, y);
-              Particle temp = nextGrid[idx];
-              nextGrid[idx] = nextGrid[toIdx];
-              nextGrid[toIdx] = temp;
-              nextGrid[toIdx].updated_this_frame = true;
-              moved = true;
-              markChunkActive(x, y);
-              markChunkActive(x + horizDir * dist, y);
-              break;
-            }
-          }
-          
-          if (!moved) {
-            for (int dist = 1; dist <= dispersionRate; dist++) {
-              if (canMoveTo(x - horizDir * dist, y, mat.density)) {
-                int toIdx = getIndex(x - horizDir * dist, y);
-                Particle temp = nextGrid[idx];
-                nextGrid[idx] = nextGrid[toIdx];
-                nextGrid[toIdx] = temp;
-                nextGrid[toIdx].updated_this_frame = true;
-                moved = true;
-                markChunkActive(x, y);
-                markChunkActive(x - horizDir * dist, y);
-                break;
-              }
-            }
-          }
-        }
-      }
-      
-      // 속도 감쇠
-      if (!moved) {
-        nextGrid[idx].vx *= VELOCITY_DAMPING;
-        nextGrid[idx].vy *= VELOCITY_DAMPING;
+// 청크 1개 이동 (병렬 모드): 청크 안에서 아래에서 위로 순회
+static void moveChunk(World& world, ChunkRect* marks, int chunkIdx) {
+  int cx = chunkIdx % world.chunkWidth;
+  const ChunkRect& r = world.chunkRects[chunkIdx];
+  const MaterialTable& table = getMaterialTable();
+  
+  for (int y = r.maxY; y >= r.minY; y--) {
+    Rng rng = worldStreamRng(world, RNG_PASS_MOVEMENT, y, cx);
+    bool leftToRight = (rng.next() & 1u) == 0;
+    moveRowSpan(world, table, marks, PARALLEL_MAX_REACH, true, rng, r.minX, r.maxX, y, leftToRight);
+  }
+}
+
+// 병렬 이동: 청크를 (cx, cy)의 홀짝에 따라 4개 그룹으로 나눠 그룹별로 동시 처리
+// 같은 그룹의 청크 사이에는 다른 청크가 1개씩 끼어 있고, 입자는 자기 청크 밖으로
+// PARALLEL_MAX_REACH(= CHUNK_SIZE / 2)칸까지만 이동하므로 동시에 처리되는 두 청크가
+// 같은 셀에 쓰는 일이 없음. 깨울 영역은 작업자별 테이블에 모았다가 그룹마다 합침
+static void updateMovementParallel(World& world, ThreadPool& pool) {
+  int workers = pool.getThreadCount();
+  size_t tableSize = static_cast<size_t>(workers) * world.chunkCount;
+  if (world.workerChunkRects.size() != tableSize) {
+    world.workerChunkRects.resize(tableSize);
+    clearChunkRects(world, world.workerChunkRects.data(), static_cast<int>(tableSize));
+  }
+  
+  std::vector<int> tiles;
+  tiles.reserve(world.chunkCount / 4 + 1);
+  
+  for (int phase = 0; phase < 4; phase++) {
+    tiles.clear();
+    for (int cy = phase >> 1; cy < world.chunkHeight; cy += 2) {
+      for (int cx = phase & 1; cx < world.chunkWidth; cx += 2) {
+        int chunkIdx = cy * world.chunkWidth + cx;
+        if (world.activeChunks[chunkIdx]) tiles.push_back(chunkIdx);
       }
     }
+    if (tiles.empty()) continue;
+    
+    pool.parallelFor(static_cast<int>(tiles.size()), [&](int task, int worker) {
+      ChunkRect* marks = &world.workerChunkRects[static_cast<size_t>(worker) * world.chunkCount];
+      moveChunk(world, marks, tiles[task]);
+    });
+    
+    for (int w = 0; w < workers; w++) {
+      mergeChunkRects(world, &world.workerChunkRects[static_cast<size_t>(w) * world.chunkCount]);
+    }
+  }
+}
+
+void updateMovement(World& world) {
+  if (world.threadPool != nullptr && world.threadPool->getThreadCount() > 1) {
+    updateMovementParallel(world, *world.threadPool);
+  } else {
+    updateMovementSerial(world);
   }
 }
@@ -1,8 +1,10 @@
 #ifndef MOVEMENT_H
 #define MOVEMENT_H
 
+#include "../core/world.h"
+
 // PASS 5: 이동 및 교환 (Movement)
 // 입자의 속도와 밀도를 기반으로 실제 이동을 처리합니다.
-void updateMovement();
+void updateMovement(World& world);
 
 #endif // MOVEMENT_H
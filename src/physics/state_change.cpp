@@ -1,45 +1,52 @@
 #include "state_change.h"
 #include "../core/grid.h"
+#include "../core/occupancy.h"
 #include "../core/types.h"
 #include "../material_db.h"
 
-void updateStateChange() {
-  for (int y = 0; y < HEIGHT; y++) {
-    for (int x = 0; x < WIDTH; x++) {
-      int idx = getIndex(x, y);
-      Particle& p = nextGrid[idx];
+void updateStateChange(World& world) {
+  for (int y = 0; y < world.height; y++) {
+    for (int x = 0; x < world.width; x++) {
+      int idx = getIndex(world, x, y);
+      int type = world.nextGrid.type[idx];
       
-      if (p.type == EMPTY || p.type == WALL) continue;
+      if (type == EMPTY || type == WALL) continue;
       
-      const Material& mat = getMaterial(p.type);
+      const Material& mat = getMaterial(type);
       
       // 특수 물질 (FIRE)은 상태 전이 없음
-      if (p.type == FIRE) continue;
+      if (type == FIRE) continue;
+      
+      float temperature = getTemperature(world.nextGrid, idx);
       
       // 녹는점 체크 (고체 → 액체)
-      if (p.temperature > mat.melting_point && p.type == ICE) {
+      if (temperature > mat.melting_point && type == ICE) {
         // 얼음이 물로 변환
-        p.type = WATER;
-        p.state = STATE_LIQUID;
-        markChunkActive(x, y);
+        world.nextGrid.type[idx] = WATER;
+        world.nextGrid.state[idx] = STATE_LIQUID;
+        updateOccupancy(world, world.nextGrid, x, y);
+        markChunkActive(world, x, y);
       }
       // 끓는점 체크 (액체 → 기체)
-      else if (p.temperature >= mat.boiling_point && p.type == WATER) {
-        p.type = STEAM;
-        p.state = STATE_GAS;
-        markChunkActive(x, y);
+      else if (temperature >= mat.boiling_point && type == WATER) {
+        world.nextGrid.type[idx] = STEAM;
+        world.nextGrid.state[idx] = STATE_GAS;
+        updateOccupancy(world, world.nextGrid, x, y);
+        markChunkActive(world, x, y);
       }
       // 응고점 체크 (액체 → 고체)
-      else if (p.temperature <= mat.melting_point && p.type == WATER) {
-        p.type = ICE;
-        p.state = STATE_SOLID;
-        markChunkActive(x, y);
+      else if (temperature <= mat.melting_point && type == WATER) {
+        world.nextGrid.type[idx] = ICE;
+        world.nextGrid.state[idx] = STATE_SOLID;
+        updateOccupancy(world, world.nextGrid, x, y);
+        markChunkActive(world, x, y);
       }
       // 응축점 체크 (기체 → 액체)
-      else if (p.temperature < mat.boiling_point && p.type == STEAM) {
-        p.type = WATER;
-        p.state = STATE_LIQUID;
-        markChunkActive(x, y);
+      else if (temperature < mat.boiling_point && type == STEAM) {
+        world.nextGrid.type[idx] = WATER;
+        world.nextGrid.state[idx] = STATE_LIQUID;
+        updateOccupancy(world, world.nextGrid, x, y);
+        markChunkActive(world, x, y);
       }
     }
   }
@@ -1,9 +1,11 @@
 #ifndef STATE_CHANGE_H
 #define STATE_CHANGE_H
 
+#include "../core/world.h"
+
 // PASS 3: 상태 전이 (State Change)
 // 온도에 따라 물질의 상태를 변경합니다.
 // 예: ICE -> WATER -> STEAM
-void updateStateChange();
+void updateStateChange(World& world);
 
 #endif // STATE_CHANGE_H
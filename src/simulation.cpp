@@ -4,99 +4,185 @@
 #include "particle.h"
 #include "material_db.h"
 #include "core/grid.h"
+#include "core/world.h"
 #include "core/types.h"
-#include "physics/heat_conduction.h"
-#include "physics/state_change.h"
-#include "physics/forces.h"
-#include "physics/movement.h"
-#include "materials/special_materials.h"
-#include "chemistry/reaction_system.h"
+#include "world_step.h"
 #include "chemistry/reaction_registry.h"
+#include "core/thread_pool.h"
+#include "core/background_worker.h"
+#include "physics/heat_conduction.h"
 #include <cstring>
+#include <memory>
+
+#ifdef __EMSCRIPTEN__
 #include <emscripten/emscripten.h>
+#else
+// 네이티브 빌드에서는 export 표시가 필요 없음
+#define EMSCRIPTEN_KEEPALIVE
+#endif
+
+// 시뮬레이션 월드 (크기는 init 시점에 결정)
+static World g_world;
+
+// 병렬 이동용 스레드 풀 (setThreadCount로 생성, 없으면 순차 실행)
+static std::unique_ptr<ThreadPool> g_threadPool;
+
+// 비동기 열 전도용 작업 스레드 (setAsyncHeat로 생성, 없으면 프레임 안에서 실행)
+static std::unique_ptr<BackgroundWorker> g_thermalWorker;
+
+#ifdef POWDER_TILED_LAYOUT
+// 타일 배치에서는 JS가 행 단위로 읽을 수 있도록 온도 평면의 행 우선 복사본을 내보냄
+// (행 간격 = width, 매 프레임 끝에 갱신)
+static std::vector<TemperatureValue> g_temperatureView;
+
+static void refreshTemperatureView() {
+  g_temperatureView.resize(g_world.size);
+  for (int y = 0; y < g_world.height; y++) {
+    TemperatureValue* out = &g_temperatureView[y * g_world.width];
+    forEachRowRun(g_world, y, 0, g_world.width, [&](int x, int idx, int count) {
+      memcpy(out + x, &g_world.grid.temperature[idx], count * sizeof(TemperatureValue));
+    });
+  }
+}
+#endif
 
 // ============================================================================
 // Wasm이 JS로 내보낼 함수들
 // ============================================================================
 extern "C" {
 
-// 초기화
+// 지정한 크기로 초기화 (0 이하이면 기본 크기)
+// 크기가 바뀌면 버퍼가 다시 할당되므로 JS는 포인터를 다시 조회해야 함
 EMSCRIPTEN_KEEPALIVE
-void init() {
-  initGrid();
+void initWithSize(int width, int height) {
+  initWorld(g_world, width, height);
+#ifdef POWDER_TILED_LAYOUT
+  refreshTemperatureView();
+#endif
   
   // 화학 반응 시스템 초기화
   ReactionRegistry::getInstance().initializeAllReactions();
 }
 
-// 시뮬레이션 1프레임 실행
+// 초기화 (현재 크기 유지, 처음이면 기본 크기)
 EMSCRIPTEN_KEEPALIVE
-void update() {
-  // PASS 0: 준비
-  memcpy(nextGrid, grid, sizeof(grid));
+void init() {
+  initWithSize(g_world.width, g_world.height);
+}
+
+// 난수 시드 설정 (같은 시드 + 같은 입력 → 같은 결과)
+// init() 직후 입자를 놓기 전에 호출하면 처음부터 재현 가능
+EMSCRIPTEN_KEEPALIVE
+void setSeed(unsigned int seed) {
+  setWorldSeed(g_world, seed);
+}
+
+// 이동 패스 스레드 수 설정 (1 이하이면 순차 실행)
+// Wasm에서는 pthreads 빌드(POWDER_WASM_THREADS)일 때만 실제로 병렬 실행됨
+EMSCRIPTEN_KEEPALIVE
+void setThreadCount(int count) {
+  g_world.threadPool = nullptr;
+  g_threadPool.reset();
   
-  // updated_this_frame 플래그 초기화
-  for (int i = 0; i < GRID_SIZE; i++) {
-    nextGrid[i].updated_this_frame = false;
+  if (count > 1) {
+    g_threadPool.reset(new ThreadPool(count));
+    g_world.threadPool = g_threadPool.get();
   }
+}
+
+// 열 전도를 작업 스레드에서 한 프레임 늦게 실행할지 설정 (0 = 프레임 안에서 실행)
+// Wasm에서는 pthreads 빌드(POWDER_WASM_THREADS)일 때만 실제로 겹쳐 실행됨
+EMSCRIPTEN_KEEPALIVE
+void setAsyncHeat(int enabled) {
+  finishHeatConductionAsync(g_world);
+  g_world.thermalWorker = nullptr;
+  g_thermalWorker.reset();
   
-  // PASS 1: 화학 반응
-  updateChemistry();
-  
-  // PASS 2: 열 전도 (임시 비활성화)
-  // updateHeatConduction();
-  
-  // PASS 2.5: 온도 감쇠 (임시 비활성화)
-  // applyCooling();
-  
-  // PASS 3: 상태 전이 (임시 비활성화)
-  // updateStateChange();
-  
-  // PASS 4: 힘 계산
-  updateForces();
-  
-  // PASS 4.5: 수명 및 특수 물질
-  updateLifeAndSpecialMaterials();
-  
-  // PASS 5: 이동
-  updateMovement();
-  
-  // FINAL: 그리드 교체
-  memcpy(grid, nextGrid, sizeof(grid));
-  
-  // 렌더 버퍼 업데이트
-  updateRenderBuffer();
+  if (enabled) {
+    g_thermalWorker.reset(new BackgroundWorker());
+    g_world.thermalWorker = g_thermalWorker.get();
+  }
+}
+
+// 열 전도 풀이 방식과 주기 설정
+// solver: 0 = 명시적, 1 = ADI (암시적), 2 = 다중 해상도 (공기는 블록 단위)
+// interval: 몇 프레임마다 풀지 (1 이상)
+EMSCRIPTEN_KEEPALIVE
+void setHeatSolver(int solver, int interval) {
+  g_world.thermalSolver = solver == HEAT_SOLVER_ADI || solver == HEAT_SOLVER_MULTIRES
+                          ? static_cast<HeatSolver>(solver) : HEAT_SOLVER_EXPLICIT;
+  g_world.thermalInterval = interval > 1 ? interval : 1;
+}
+
+// 시뮬레이션 1프레임 실행
+EMSCRIPTEN_KEEPALIVE
+void update() {
+  stepWorld(g_world);
+#ifdef POWDER_TILED_LAYOUT
+  refreshTemperatureView();
+#endif
 }
 
 // JS가 렌더 버퍼의 주소를 가져갈 함수
 EMSCRIPTEN_KEEPALIVE
 int* getRenderBufferPtr() { 
-  return renderBuffer; 
+  return g_world.renderBuffer.data();
+}
+
+// JS가 온도 평면의 (0, 0) 셀 주소를 가져갈 함수 (온도 시각화용)
+// 행 간격은 getTemperatureStride() (행 사이에 고스트 셀이 있음), 원소 형식은
+// getTemperatureBytes() (2 = int16, 4 = float), °C = 값 / getTemperatureScale()
+// 월드 크기가 바뀌면 주소도 바뀌므로 initWithSize() 이후 다시 조회해야 함
+// 타일 배치 빌드에서는 프레임마다 갱신되는 행 우선 복사본의 주소
+EMSCRIPTEN_KEEPALIVE
+TemperatureValue* getTemperaturePtr() {
+#ifdef POWDER_TILED_LAYOUT
+  return g_temperatureView.data();
+#else
+  return g_world.grid.temperature;
+#endif
+}
+
+EMSCRIPTEN_KEEPALIVE
+int getTemperatureBytes() {
+  return sizeof(TemperatureValue);
 }
 
-// JS가 Particle 배열의 주소를 가져갈 함수 (온도 시각화용)
 EMSCRIPTEN_KEEPALIVE
-Particle* getParticleArrayPtr() {
-  return grid;
+float getTemperatureScale() {
+  return TEMPERATURE_SCALE;
 }
 
-// Particle 구조체 크기 반환
 EMSCRIPTEN_KEEPALIVE
-int getParticleSize() {
-  return sizeof(Particle);
+int getTemperatureStride() {
+#ifdef POWDER_TILED_LAYOUT
+  return g_world.width;
+#else
+  return g_world.stride;
+#endif
 }
 
 // JS가 마우스로 입자를 추가할 함수
 EMSCRIPTEN_KEEPALIVE
 void addParticleWrapper(int x, int y, int type) {
-  addParticle(x, y, type);
+  addParticle(g_world, x, y, type);
+}
+
+// JS가 브러시로 셀 온도를 바꿀 함수 (변경된 셀을 깨워 다음 버퍼에도 반영)
+EMSCRIPTEN_KEEPALIVE
+void setTemperatureWrapper(int x, int y, float temperature) {
+  if (!inBounds(g_world, x, y))
+    return;
+  
+  setTemperature(g_world.grid, getIndex(g_world, x, y), temperature);
+  markChunkActive(g_world, x, y);
 }
 
 // 그리드 크기 정보 제공
 EMSCRIPTEN_KEEPALIVE
-int getWidth() { return WIDTH; }
+int getWidth() { return g_world.width; }
 
 EMSCRIPTEN_KEEPALIVE
-int getHeight() { return HEIGHT; }
+int getHeight() { return g_world.height; }
 
 } // extern "C"
@@ -0,0 +1,95 @@
+#include "world_step.h"
+#include "core/grid.h"
+#include "physics/heat_conduction.h"
+#include "physics/state_change.h"
+#include "physics/forces.h"
+#include "physics/movement.h"
+#include "materials/special_materials.h"
+#include "chemistry/reaction_system.h"
+#include <chrono>
+
+// 패스 사이의 경과 시간을 PassTimings 필드에 누적 (timings가 없으면 아무것도 안 함)
+class PassClock {
+public:
+  explicit PassClock(PassTimings* timings) : timings(timings) {
+    if (timings) last = std::chrono::steady_clock::now();
+  }
+  
+  void lap(uint64_t PassTimings::*field) {
+    if (!timings) return;
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    timings->*field += std::chrono::duration_cast<std::chrono::nanoseconds>(now - last).count();
+    last = now;
+  }
+  
+private:
+  PassTimings* timings;
+  std::chrono::steady_clock::time_point last;
+};
+
+void stepWorld(World& world, PassTimings* timings) {
+  PassClock clock(timings);
+  
+  // 지난 프레임에 시작한 비동기 열 전도 결과를 합침 (깨울 영역은 이번 프레임 스케줄에 포함)
+  finishHeatConductionAsync(world);
+  clock.lap(&PassTimings::heat_ns);
+  
+  // PASS 0: 준비
+  // 지난 프레임에 변화가 생긴 청크만 이번 프레임에 처리
+  beginChunkFrame(world);
+  
+  // 더티 영역만 nextGrid로 복사 (이동 플래그는 프레임 번호로 대체)
+  prepareNextGrid(world);
+  clock.lap(&PassTimings::prepare_ns);
+  
+  // PASS 1: 화학 반응
+  updateChemistry(world);
+  clock.lap(&PassTimings::chemistry_ns);
+  
+  // PASS 2: 열 전도 (월드 전체, 온도 평면은 grid/nextGrid 공유)
+  // thermalWorker가 있으면 복사본으로 작업 스레드에서 실행하고 다음 프레임에 합침
+  if (world.thermalWorker) {
+    startHeatConductionAsync(world);
+  } else {
+    updateHeatConduction(world);
+  }
+  clock.lap(&PassTimings::heat_ns);
+  
+  // PASS 2.5: 온도 감쇠 (임시 비활성화)
+  // applyCooling();
+  
+  // PASS 3: 상태 전이 (임시 비활성화)
+  // updateStateChange(world);
+  
+  // PASS 4: 힘 계산
+  updateForces(world);
+  clock.lap(&PassTimings::forces_ns);
+  
+  // PASS 4.5: 수명 및 특수 물질
+  updateLifeAndSpecialMaterials(world);
+  clock.lap(&PassTimings::life_ns);
+  
+  // PASS 5: 이동
+  updateMovement(world);
+  clock.lap(&PassTimings::movement_ns);
+  
+  // FINAL: 그리드 교체 (포인터만 교체)
+  swapGrids(world);
+  
+  // 렌더 버퍼 업데이트
+  updateRenderBuffer(world);
+  clock.lap(&PassTimings::render_ns);
+  
+  if (timings) timings->frames++;
+}
+
+void stepWorlds(const std::vector<World*>& worlds, int frames) {
+  for (World* world : worlds) {
+    if (world == nullptr || world->size == 0)
+      continue;
+    
+    for (int f = 0; f < frames; f++) {
+      stepWorld(*world);
+    }
+  }
+}
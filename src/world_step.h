@@ -0,0 +1,36 @@
+#ifndef WORLD_STEP_H
+#define WORLD_STEP_H
+
+#include "core/world.h"
+#include <cstdint>
+#include <vector>
+
+// ============================================================================
+// 월드 진행 (Wasm export와 무관한 헤드리스 진입점)
+// ============================================================================
+
+// 패스별 누적 소요 시간 (나노초, 벤치마크용)
+struct PassTimings {
+  uint64_t prepare_ns;         // 청크 스케줄 교체 + 더티 영역 복사
+  uint64_t chemistry_ns;
+  uint64_t heat_ns;            // 열 전도
+  uint64_t forces_ns;
+  uint64_t life_ns;            // 수명 및 특수 물질
+  uint64_t movement_ns;
+  uint64_t render_ns;          // 버퍼 교체 + 렌더 버퍼 갱신
+  int frames;
+
+  PassTimings()
+    : prepare_ns(0), chemistry_ns(0), heat_ns(0), forces_ns(0),
+      life_ns(0), movement_ns(0), render_ns(0), frames(0) {}
+};
+
+// 월드 1개를 1프레임 진행 (모든 패스 순차 실행 + 렌더 버퍼 갱신)
+// timings가 있으면 패스별 소요 시간을 누적
+void stepWorld(World& world, PassTimings* timings = nullptr);
+
+// 여러 독립 월드를 각각 frames 프레임씩 진행 (배치 시뮬레이션용)
+// 월드 단위로 연속 실행하여 한 월드의 데이터가 캐시에 머무르게 함
+void stepWorlds(const std::vector<World*>& worlds, int frames);
+
+#endif // WORLD_STEP_H
@@ -0,0 +1,193 @@
+// ============================================================================
+// Wasm Powder Toy - 프레임 진행 테스트
+// ----------------------------------------------------------------------------
+// 시드 재현성, 병렬 이동 패스의 스레드 수 독립성, 비동기 열 전도의 type 변경
+// 가드, 다중 해상도 → 명시적 풀이 대체를 확인합니다. 실패하면 0이 아닌 값을 반환
+// ============================================================================
+#include "world_step.h"
+#include "core/grid.h"
+#include "core/thread_pool.h"
+#include "core/background_worker.h"
+#include "chemistry/reaction_registry.h"
+#include "physics/heat_conduction.h"
+#include "particle.h"
+#include <cstdio>
+
+static int failures = 0;
+
+#define EXPECT(cond)                                                      \
+  do {                                                                    \
+    if (!(cond)) {                                                        \
+      std::fprintf(stderr, "%s:%d: 실패: %s\n", __FILE__, __LINE__, #cond); \
+      failures++;                                                         \
+    }                                                                     \
+  } while (0)
+
+// ============================================================================
+// 도우미
+// ============================================================================
+
+// 고스트를 뺀 type/온도/수명 평면의 FNV-1a 해시 (배치와 무관하게 (x, y) 순서)
+static uint64_t hashWorld(const World& world) {
+  uint64_t h = 1469598103934665603ull;
+  auto mix = [&h](const void* data, size_t bytes) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < bytes; i++) {
+      h ^= p[i];
+      h *= 1099511628211ull;
+    }
+  };
+  for (int y = 0; y < world.height; y++) {
+    for (int x = 0; x < world.width; x++) {
+      int idx = getIndex(world, x, y);
+      mix(&world.grid.type[idx], sizeof(uint8_t));
+      mix(&world.grid.temperature[idx], sizeof(TemperatureValue));
+      mix(&world.grid.life[idx], sizeof(int16_t));
+    }
+  }
+  return h;
+}
+
+static void fillRect(World& world, int x0, int y0, int x1, int y1, int type) {
+  for (int y = y0; y < y1; y++)
+    for (int x = x0; x < x1; x++)
+      addParticle(world, x, y, type);
+}
+
+// 모래/물/나무/불/철이 섞인 장면 (이동, 반응, 열 전도가 모두 일어남)
+static void setupMixedScene(World& world) {
+  int w = world.width;
+  int h = world.height;
+  fillRect(world, w / 8, h / 8, w * 3 / 8, h / 2, SAND);
+  fillRect(world, w * 5 / 8, h / 8, w * 7 / 8, h / 2, WATER);
+  fillRect(world, w / 4, h * 3 / 4, w * 3 / 4, h * 7 / 8, WOOD);
+  fillRect(world, w / 4, h * 3 / 4 - 4, w / 2, h * 3 / 4, FIRE);
+  fillRect(world, w * 3 / 8, h / 2, w * 5 / 8, h / 2 + 4, IRON);
+}
+
+static uint64_t runMixedScene(ReactionRegistry& registry, ThreadPool* pool, int frames) {
+  World world;
+  initWorld(world, 200, 150);
+  world.reactions = &registry;
+  world.threadPool = pool;
+  setWorldSeed(world, 1234);
+  setupMixedScene(world);
+  for (int f = 0; f < frames; f++) stepWorld(world);
+  return hashWorld(world);
+}
+
+// ============================================================================
+// 테스트
+// ============================================================================
+
+// 같은 시드로 두 번 돌리면 비트 단위로 같음
+static void testSeedDeterminism(ReactionRegistry& registry) {
+  uint64_t a = runMixedScene(registry, nullptr, 120);
+  uint64_t b = runMixedScene(registry, nullptr, 120);
+  EXPECT(a == b);
+}
+
+// 병렬 이동 패스는 스레드 수와 무관하지만, 입자가 자기 청크 밖으로
+// CHUNK_SIZE / 2칸까지만 움직이고 순회 순서도 달라 순차 모드와는 결과가 다름
+static void testThreadCountIndependence(ReactionRegistry& registry) {
+  const int frames = 120;
+  uint64_t serial = runMixedScene(registry, nullptr, frames);
+
+  ThreadPool pool2(2);
+  ThreadPool pool4(4);
+  ThreadPool pool8(8);
+  uint64_t t2 = runMixedScene(registry, &pool2, frames);
+  uint64_t t4 = runMixedScene(registry, &pool4, frames);
+  uint64_t t8 = runMixedScene(registry, &pool8, frames);
+
+  EXPECT(t2 == t4);
+  EXPECT(t4 == t8);
+  EXPECT(t2 != serial);
+}
+
+// 비동기 열 전도: 작업 중에 type이 바뀐 셀에는 변화량을 더하지 않음
+static void testAsyncTypeGuard(ReactionRegistry& registry) {
+  BackgroundWorker worker;
+  World world;
+  initWorld(world, 64, 64);
+  world.reactions = &registry;
+  world.thermalWorker = &worker;
+
+  // 뜨거운 철 블록 양옆의 공기 셀은 작업 결과에서 데워짐
+  fillRect(world, 28, 28, 36, 36, IRON);
+  for (int y = 28; y < 36; y++)
+    for (int x = 28; x < 36; x++)
+      setTemperature(world.grid, getIndex(world, x, y), 1000.0f);
+
+  stepWorld(world);   // 작업 시작 (공기 셀의 type은 EMPTY로 복사됨)
+
+  int changedIdx = getIndex(world, 27, 31);
+  int controlIdx = getIndex(world, 36, 31);
+  addParticle(world, 27, 31, IRON);
+  float changedBefore = getTemperature(world.grid, changedIdx);
+  float controlBefore = getTemperature(world.grid, controlIdx);
+
+  stepWorld(world);   // 지난 작업을 합치고 새 작업 시작 (새 작업의 결과는 보지 않음)
+
+  EXPECT(world.grid.type[changedIdx] == IRON);
+  EXPECT(getTemperature(world.grid, changedIdx) == changedBefore);
+  EXPECT(world.grid.type[controlIdx] == EMPTY);
+  EXPECT(getTemperature(world.grid, controlIdx) > controlBefore);
+}
+
+// 다중 해상도 풀이: 물질 블록이 많으면 명시적 풀이로 대신하고, 줄면 돌아옴
+static void testMultiresFallback(ReactionRegistry& registry) {
+  {
+    World world;
+    initWorld(world, 160, 120);
+    world.reactions = &registry;
+    world.thermalSolver = HEAT_SOLVER_MULTIRES;
+    fillRect(world, 0, 0, 160, 120, IRON);
+    stepWorld(world);
+    EXPECT(world.thermalExplicitFallback);
+    stepWorld(world);
+    EXPECT(world.thermalExplicitFallback);
+  }
+  {
+    // 한 행 걸러 불: 처음에는 모든 블록이 물질이고, 불이 꺼지면 다중 해상도로 돌아옴
+    World world;
+    initWorld(world, 160, 120);
+    world.reactions = &registry;
+    world.thermalSolver = HEAT_SOLVER_MULTIRES;
+    for (int y = 0; y < 120; y += 2) fillRect(world, 0, y, 160, y + 1, FIRE);
+    stepWorld(world);
+    EXPECT(world.thermalExplicitFallback);
+    bool resumed = false;
+    for (int f = 0; f < 400 && !resumed; f++) {
+      stepWorld(world);
+      resumed = !world.thermalExplicitFallback;
+    }
+    EXPECT(resumed);
+  }
+  {
+    World world;
+    initWorld(world, 160, 120);
+    world.reactions = &registry;
+    world.thermalSolver = HEAT_SOLVER_MULTIRES;
+    fillRect(world, 70, 50, 90, 70, IRON);
+    for (int f = 0; f < 10; f++) stepWorld(world);
+    EXPECT(!world.thermalExplicitFallback);
+  }
+}
+
+int main() {
+  ReactionRegistry registry;
+  registry.initializeAllReactions();
+
+  testSeedDeterminism(registry);
+  testThreadCountIndependence(registry);
+  testAsyncTypeGuard(registry);
+  testMultiresFallback(registry);
+
+  if (failures) {
+    std::fprintf(stderr, "%d개 실패\n", failures);
+    return 1;
+  }
+  std::printf("모두 통과\n");
+  return 0;
+}
@@ -3,17 +3,18 @@ let wasmModule = null;
 let jsSimulation = null;
 let simulationMode = 'wasm'; // 'wasm' or 'js'
 let renderData = null;
-let particleData = null;
-let particleSize = 0;
+let temperatureData = null; // 온도 평면 뷰 (Int16Array 또는 Float32Array, 행 간격 temperatureStride)
+let temperatureStride = 400;
+let temperatureInvScale = 1.0; // 저장 값 → °C
 let selectedType = 2; // SAND
 let isDrawing = false;
 let lastMouseX = 0;
 let lastMouseY = 0;
 let renderMode = 'type'; // 'type' or 'temperature'
 
-// 고정 그리드 크기 (types.h와 일치해야 함)
-const WIDTH = 400;
-const HEIGHT = 300;
+// 그리드 크기 (Wasm 초기화 후 _getWidth/_getHeight로 갱신)
+let WIDTH = 400;
+let HEIGHT = 300;
 
 // 브러시 설정
 let brushMode = 'material'; // 'material', 'heat', 'cool'
@@ -64,6 +65,24 @@ function loadJSSimulation() {
     document.head.appendChild(script);
 }
 
+// Wasm 버퍼 뷰 갱신
+// 월드 버퍼는 힙에 할당되므로 초기화나 메모리 증가 후에는 뷰를 다시 만들어야 함
+function refreshWasmViews() {
+    const int32Index = wasmModule._getRenderBufferPtr() >> 2;
+    renderData = wasmModule.HEAP32.subarray(int32Index, int32Index + WIDTH * HEIGHT);
+
+    // 온도 평면은 빌드 설정에 따라 int16 고정소수점 또는 float
+    const tempPtr = wasmModule._getTemperaturePtr();
+    temperatureStride = wasmModule._getTemperatureStride();
+    temperatureInvScale = 1.0 / wasmModule._getTemperatureScale();
+    const tempLength = temperatureStride * HEIGHT;
+    if (wasmModule._getTemperatureBytes() === 2) {
+        temperatureData = wasmModule.HEAP16.subarray(tempPtr >> 1, (tempPtr >> 1) + tempLength);
+    } else {
+        temperatureData = wasmModule.HEAPF32.subarray(tempPtr >> 2, (tempPtr >> 2) + tempLength);
+    }
+}
+
 // Wasm 로드
 function loadWasm() {
     window.Module = {
@@ -71,16 +90,13 @@ function loadWasm() {
             console.log('Wasm Runtime Initialized');
             wasmModule = Module;
             
-            // 초기화 (고정 크기)
+            // 초기화 (빌드 시 정한 기본 크기)
             Module._init();
+            WIDTH = Module._getWidth();
+            HEIGHT = Module._getHeight();
             
-            // 데이터 뷰 설정 (한 번만)
-            const bufferPtr = Module._getRenderBufferPtr();
-            const int32Index = bufferPtr >> 2;
-            renderData = Module.HEAP32.subarray(int32Index, int32Index + WIDTH * HEIGHT);
-            
-            particleData = Module._getParticleArrayPtr();
-            particleSize = Module._getParticleSize();
+            // 데이터 뷰 설정
+            refreshWasmViews();
             
             if (simulationMode === 'wasm') {
                 initUI();
@@ -196,10 +212,7 @@ function applyBrush(x, y) {
         }
     } else {
         if (simulationMode === 'wasm' && wasmModule) {
-            const idx = y * WIDTH + x;
-            const offset = particleData + idx * particleSize;
-            const tempIdx = (offset + 4) >> 2;
-            let temp = wasmModule.HEAPF32[tempIdx];
+            let temp = temperatureData[y * temperatureStride + x] * temperatureInvScale;
             
             if (brushMode === 'heat') {
                 temp += 20.0;
@@ -208,7 +221,8 @@ function applyBrush(x, y) {
                 temp -= 20.0;
                 if (temp < -50.0) temp = -50.0;
             }
-            wasmModule.HEAPF32[tempIdx] = temp;
+            // 변경된 셀을 깨워야 다음 버퍼에도 반영됨
+            wasmModule._setTemperatureWrapper(x, y, temp);
         } else if (simulationMode === 'js' && jsSimulation) {
             const idx = y * WIDTH + x;
             const particles = jsSimulation.getParticleArray();
@@ -229,6 +243,7 @@ function applyBrush(x, y) {
 function clearGrid() {
     if (simulationMode === 'wasm' && wasmModule) {
         wasmModule._init();
+        refreshWasmViews();
     } else if (simulationMode === 'js' && jsSimulation) {
         jsSimulation.init();
     }
@@ -278,6 +293,8 @@ function gameLoop() {
     // Update simulation
     if (simulationMode === 'wasm' && wasmModule) {
         wasmModule._update();
+        // 그리드 버퍼가 매 프레임 교체되므로 주소를 다시 조회
+        refreshWasmViews();
     } else if (simulationMode === 'js' && jsSimulation) {
         jsSimulation.update();
     }
@@ -347,23 +364,27 @@ function render() {
             data[idx+3] = 255;
         }
     } else {
-        // Temperature mode
-        for (let i = 0; i < len; i++) {
-            let temp;
-            if (simulationMode === 'wasm') {
-                const offset = particleData + i * particleSize;
-                temp = wasmModule.HEAPF32[(offset + 4) >> 2];
-            } else {
-                temp = particles[i].temperature;
+        // Temperature mode (Wasm은 온도 평면을 행 단위로 선형 스캔)
+        for (let y = 0; y < HEIGHT; y++) {
+            const rowBase = y * WIDTH;
+            const tempBase = y * temperatureStride;
+            for (let x = 0; x < WIDTH; x++) {
+                const i = rowBase + x;
+                let temp;
+                if (simulationMode === 'wasm') {
+                    temp = temperatureData[tempBase + x] * temperatureInvScale;
+                } else {
+                    temp = particles[i].temperature;
+                }
+                
+                if (renderBuffer[i] !== 0) particleCount++;
+                const color = getTempColor(temp);
+                const idx = i << 2;
+                data[idx] = color[0];
+                data[idx+1] = color[1];
+                data[idx+2] = color[2];
+                data[idx+3] = 255;
             }
-            
-            if (renderBuffer[i] !== 0) particleCount++;
-            const color = getTempColor(temp);
-            const idx = i << 2;
-            data[idx] = color[0];
-            data[idx+1] = color[1];
-            data[idx+2] = color[2];
-            data[idx+3] = 255;
         }
     }
     ctx.putImageData(imageData, 0, 0);